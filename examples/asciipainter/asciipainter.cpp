@@ -103,9 +103,9 @@ conu::Menu exportMenu;
 // interface.
 namespace canvas {
 
-// Pointer to the canvas object
-conu::Graphic* canvasPtr = nullptr;
-conu::HorizContainer* canvasBorderPtr = nullptr;
+// Handles to the canvas object
+conu::BoxHandle<conu::Graphic> canvasHandle;
+conu::BoxHandle<conu::HorizContainer> canvasBorderHandle;
 
 // Dimensions of the canvas object
 int width = 80;
@@ -330,23 +330,20 @@ void buildPaintInterface() {
     //
     // Canvas region
     //
-    conu::HorizContainer canvasBorder(canvas::width + 2, canvas::height + 2);
+    conu::HorizContainer& canvasBorder =
+            screen::paintMenu.emplace<conu::HorizContainer>(
+            canvas::width + 2, canvas::height + 2);
     canvasBorder.setAlignment(conu::Align::CENTER | conu::Align::MIDDLE);
     canvasBorder.setBorderSize(1);
     canvasBorder.setBorderFill(style::thinFill);
-    screen::paintMenu.insert(canvasBorder);
 
-    // Save border ptr reference
-    canvas::canvasBorderPtr = dynamic_cast<conu::HorizContainer*>(
-            screen::paintMenu.getRecent());
+    // Save border handle
+    canvas::canvasBorderHandle = conu::BoxHandle<conu::HorizContainer>(
+            canvasBorder);
 
-    // Canvas
-    conu::Graphic canvas(canvas::width, canvas::height);
-    canvas::canvasBorderPtr->insert(canvas);
-
-    // Save canvas ptr reference
-    canvas::canvasPtr = dynamic_cast<conu::Graphic*>(
-            canvas::canvasBorderPtr->getRecent());
+    // Canvas and canvas handle
+    canvas::canvasHandle = conu::BoxHandle<conu::Graphic>(
+            canvasBorder.emplace<conu::Graphic>(canvas::width, canvas::height));
 
     //
     // Spacer 1
@@ -435,7 +432,7 @@ void buildPaintInterface() {
     utilButton.setAction([](conu::Button& self, 
                 conu::inputEvent::MouseEvent input)->conu::Reply {
             if (style::clickEffect(self, input) == conu::Reply::CONTINUE) {
-                canvas::canvasPtr->clear();
+                canvas::canvasHandle->clear();
             }
             return conu::Reply::CONTINUE;
         });
@@ -713,8 +710,8 @@ void resizeCanvas() {
         canvas::height = canvas::maxHeight;
     }
 
-    canvas::canvasPtr->setDimensions(canvas::width, canvas::height);
-    canvas::canvasBorderPtr->setDimensions(canvas::width + 2, 
+    canvas::canvasHandle->setDimensions(canvas::width, canvas::height);
+    canvas::canvasBorderHandle->setDimensions(canvas::width + 2, 
             canvas::height + 2);
 }
 
@@ -741,25 +738,31 @@ void resizeMenuWindow(conu::Menu& menu, int vertPadding, int horizPadding) {
 void drawHandler(conu::InputEvent& input) {
     static conu::ConsoleEditor& console = conu::ConsoleEditor::getInstance();
 
-    if (canvas::canvasPtr == nullptr) {
+    if (!canvas::canvasHandle) {
         return;
     }
 
     if (input.type != conu::inputEvent::Type::MOUSE_INPUT
-            || !canvas::canvasPtr->posInBounds(input.info.mouse.mousePosition)) {
+            || !canvas::canvasHandle->posInBounds(
+            input.info.mouse.mousePosition)) {
         return;
     }
 
+    // Connect consecutive mouse positions with a line so that fast strokes
+    // do not leave gaps
+    conu::GraphicPainter painter(*canvas::canvasHandle);
+    conu::Position offset = canvas::canvasHandle->getPosition();
+    conu::Position prevCell = conu::Position{
+            input.info.mouse.mousePosition.col - offset.col,
+            input.info.mouse.mousePosition.row - offset.row };
     while (input.type == conu::inputEvent::Type::MOUSE_INPUT 
             && input.info.mouse.leftClick) {
 
         conu::Position mousePos = input.info.mouse.mousePosition;
-        //mousePos.col--;
-        if (canvas::canvasPtr->posInBounds(mousePos)) {
-            conu::Position offset = canvas::canvasPtr->getPosition();
-            (*canvas::canvasPtr)[mousePos.row - offset.row]
-                    [mousePos.col - offset.col] = selection::brush;
-        }
+        conu::Position currCell = conu::Position{ mousePos.col - offset.col,
+                mousePos.row - offset.row };
+        painter.drawLine(prevCell, currCell, selection::brush);
+        prevCell = currCell;
 
         input = console.getRawInput();
     }
@@ -785,7 +788,7 @@ void keyHandler(conu::InputEvent& input) {
 
 // Copy the contents of the drawing canvas to the Winows clipboard
 void copyCanvas() {
-    std::string clipData = canvas::canvasPtr->getString();
+    std::string clipData = canvas::canvasHandle->getString();
     HGLOBAL globalData = GlobalAlloc(GMEM_MOVEABLE, clipData.size() + 1);
     if (globalData != NULL) {
         memcpy(GlobalLock(globalData), clipData.c_str(), clipData.size() + 1);
@@ -810,6 +813,6 @@ void exportCanvas() {
         return;
     }
 
-    fout << canvas::canvasPtr->getString() << std::endl;
+    fout << canvas::canvasHandle->getString() << std::endl;
     fout.close();
 }
\ No newline at end of file
@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+// boxfootprint.cpp
+// Footprint report and traversal benchmark for 100 thousand small Boxes.
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Program Description: Prints the size of each Box class, then builds a grid
+//     of 1000 HorizContainers that each hold 100 Spacers, TextBoxes, and
+//     Buttons, and reports the heap memory held per Box. Times laying out and
+//     buffering frames of the grid, and sending clicks that are routed through
+//     the grid to the clicked Box. Heap memory is counted by replacing the
+//     global allocation functions.
+//
+// Dependencies: ConsoleMenu Library
+//     Library Link: https://github.com/Ringman3640/ConsoleMenu
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "consolemenu.h"
+
+const int ROWS = 1000;
+const int COLS = 100;
+const int FRAMES = 50;
+const int CLICKS = 2000;
+
+typedef std::chrono::steady_clock Clock;
+
+// Bytes currently allocated from the free store
+std::atomic<long long> heapBytes{ 0 };
+
+// Each allocation is prefixed with its size so that it can be subtracted when
+// the allocation is freed
+void* operator new(std::size_t size) {
+	std::size_t* region = static_cast<std::size_t*>(
+			std::malloc(size + alignof(std::max_align_t)));
+	if (region == nullptr) {
+		throw std::bad_alloc();
+	}
+	*region = size;
+	heapBytes += size;
+	return reinterpret_cast<char*>(region) + alignof(std::max_align_t);
+}
+
+void operator delete(void* ptr) noexcept {
+	if (ptr == nullptr) {
+		return;
+	}
+	std::size_t* region = reinterpret_cast<std::size_t*>(
+			static_cast<char*>(ptr) - alignof(std::max_align_t));
+	heapBytes -= *region;
+	std::free(region);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	operator delete(ptr);
+}
+
+double elapsedUs(Clock::time_point start) {
+	std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+	return elapsed.count();
+}
+
+int main() {
+	std::printf("sizeof: Spacer %zu, TextBox %zu, Graphic %zu, Button %zu, "
+			"ExitButton %zu, MenuButton %zu, EntryTextBox %zu, "
+			"VertContainer %zu, HorizContainer %zu\n", sizeof(conu::Spacer),
+			sizeof(conu::TextBox), sizeof(conu::Graphic), sizeof(conu::Button),
+			sizeof(conu::ExitButton), sizeof(conu::MenuButton),
+			sizeof(conu::EntryTextBox), sizeof(conu::VertContainer),
+			sizeof(conu::HorizContainer));
+
+	// Every third Box of a row is a Spacer, TextBox, or Button
+	long long baseline = heapBytes;
+	conu::VertContainer grid(conu::MAXIMUM, conu::MAXIMUM);
+	int clicked = 0;
+	for (int row = 0; row < ROWS; ++row) {
+		conu::HorizContainer& line = grid.emplace<conu::HorizContainer>(
+				COLS * 3, 1);
+		for (int col = 0; col < COLS; ++col) {
+			if (col % 3 == 0) {
+				line.emplace<conu::Spacer>(3, 1);
+			}
+			else if (col % 3 == 1) {
+				line.emplace<conu::TextBox>(3, 1, "ab");
+			}
+			else {
+				conu::Button& button = line.emplace<conu::Button>(3, 1, "ok");
+				button.setAction([&clicked](conu::Button&) {
+					++clicked;
+					return conu::Reply::CONTINUE;
+				});
+			}
+		}
+	}
+	long long bytes = heapBytes - baseline;
+	std::printf("%d Boxes: %lld heap bytes, %.1f bytes/Box\n", ROWS * COLS,
+			bytes, (double)bytes / (ROWS * COLS));
+
+	// Lay out and buffer the grid with the whole grid inside the container so
+	// that every Box is placed
+	conu::Boundary gridBound{ 0, 0, COLS * 3 - 1, ROWS - 1 };
+	grid.buffer(conu::Position{ 0, 0 }, gridBound);
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < FRAMES; ++i) {
+		grid.buffer(conu::Position{ 0, 0 }, gridBound);
+	}
+	std::printf("Lay out and buffer: %10.1f us/frame\n",
+			elapsedUs(start) / FRAMES);
+
+	// Click Buttons spread over the visible rows
+	conu::ConsoleEditor& console = conu::ConsoleEditor::getInstance();
+	int visibleRows = console.getWindowDimensions().row;
+	conu::inputEvent::MouseEvent click{ };
+	click.eventFlag = conu::inputEvent::Mouse::CLICKED;
+	click.leftClick = true;
+	start = Clock::now();
+	for (int i = 0; i < CLICKS; ++i) {
+		click.mousePosition = conu::Position{ (i * 7 % (COLS / 3)) * 9 + 6,
+				i % visibleRows };
+		grid.interact(click);
+	}
+	std::printf("Click:              %10.2f us/click (%d handled)\n",
+			elapsedUs(start) / CLICKS, clicked);
+
+	return 0;
+}
\ No newline at end of file
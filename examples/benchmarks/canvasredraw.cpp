@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+// canvasredraw.cpp
+// Benchmark for clearing and redrawing a 400x120 Graphic at 60 frames/s.
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Program Description: Fills a 400x120 console window with a Graphic and
+//     animates it by clearing the canvas, writing a scrolling sine wave cell
+//     by cell and a block of status rows line by line, and buffering the
+//     Graphic every frame. Times each of the three steps over unpaced frames,
+//     then runs the animation paced at 60 frames per second and counts the
+//     frames that missed their deadline. The frames are never written to the
+//     console.
+//
+// Dependencies: ConsoleMenu Library
+//     Library Link: https://github.com/Ringman3640/ConsoleMenu
+//------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include "consolemenu.h"
+
+const int CANVAS_WIDTH = 400;
+const int CANVAS_HEIGHT = 120;
+const int STATUS_ROWS = 10;
+const int FRAMES = 600;
+const int PACED_FRAMES = 300;
+
+typedef std::chrono::steady_clock Clock;
+
+double elapsedUs(Clock::time_point start, Clock::time_point end) {
+	std::chrono::duration<double, std::micro> elapsed = end - start;
+	return elapsed.count();
+}
+
+// Write the frame-th frame of the animation into the Graphic
+void drawScene(conu::Graphic& graphic, int frame) {
+	for (int col = 0; col < CANVAS_WIDTH; ++col) {
+		double phase = (col + frame) * 0.05;
+		int row = STATUS_ROWS + (int)((CANVAS_HEIGHT - STATUS_ROWS - 1)
+				* (0.5 + 0.5 * std::sin(phase)));
+		graphic[row][col] = '*';
+	}
+	for (int row = 0; row < STATUS_ROWS; ++row) {
+		graphic[row] = "Frame " + std::to_string(frame) + " row "
+				+ std::to_string(row) + std::string(40, '=');
+	}
+}
+
+void bufferGraphic(conu::Graphic& graphic, const conu::Boundary& winBound) {
+	conu::ConsoleEditor& console = conu::ConsoleEditor::getInstance();
+	console.lockWriteBuffer();
+	graphic.buffer(conu::Position{ 0, 0 }, winBound);
+	console.unlockWriteBuffer();
+}
+
+int main() {
+	conu::ConsoleEditor& console = conu::ConsoleEditor::getInstance();
+	console.setWindowDimensions(CANVAS_WIDTH, CANVAS_HEIGHT);
+	conu::Boundary winBound = console.getWindowBoundary();
+	conu::Graphic graphic(CANVAS_WIDTH, CANVAS_HEIGHT);
+	bufferGraphic(graphic, winBound);
+
+	double clearTime = 0;
+	double drawTime = 0;
+	double bufferTime = 0;
+	for (int frame = 0; frame < FRAMES; ++frame) {
+		Clock::time_point start = Clock::now();
+		graphic.clear();
+		Clock::time_point cleared = Clock::now();
+		drawScene(graphic, frame);
+		Clock::time_point drawn = Clock::now();
+		bufferGraphic(graphic, winBound);
+		Clock::time_point buffered = Clock::now();
+
+		clearTime += elapsedUs(start, cleared);
+		drawTime += elapsedUs(cleared, drawn);
+		bufferTime += elapsedUs(drawn, buffered);
+	}
+	std::printf("%dx%d canvas, %d frames\n", CANVAS_WIDTH, CANVAS_HEIGHT,
+			FRAMES);
+	std::printf("Clear:  %8.1f us/frame\n", clearTime / FRAMES);
+	std::printf("Draw:   %8.1f us/frame\n", drawTime / FRAMES);
+	std::printf("Buffer: %8.1f us/frame\n", bufferTime / FRAMES);
+	std::printf("Total:  %8.1f us/frame (%.1f%% of a 60 fps frame)\n",
+			(clearTime + drawTime + bufferTime) / FRAMES,
+			(clearTime + drawTime + bufferTime) / FRAMES / 166.67);
+
+	// Paced at 60 frames per second
+	std::chrono::microseconds period(16667);
+	Clock::time_point deadline = Clock::now() + period;
+	int missed = 0;
+	double worst = 0;
+	for (int frame = 0; frame < PACED_FRAMES; ++frame) {
+		Clock::time_point start = Clock::now();
+		graphic.clear();
+		drawScene(graphic, frame);
+		bufferGraphic(graphic, winBound);
+		Clock::time_point end = Clock::now();
+		if (elapsedUs(start, end) > worst) {
+			worst = elapsedUs(start, end);
+		}
+		if (end > deadline) {
+			++missed;
+		}
+		std::this_thread::sleep_until(deadline);
+		deadline += period;
+	}
+	std::printf("Paced at 60 fps: %d of %d deadlines missed, worst frame "
+			"%.1f us\n", missed, PACED_FRAMES, worst);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+// containerbuild.cpp
+// Benchmark for building and buffering a BoxContainer of 10 thousand Boxes.
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Program Description: Builds a VertContainer of 10 thousand TextBoxes by
+//     appending each Box at the next free layer, and again by inserting each
+//     Box below the previous one at explicitly given descending layers. Times
+//     both builds, buffering frames of the container, sending clicks to the
+//     contained Boxes, and removing every Box.
+//
+// Dependencies: ConsoleMenu Library
+//     Library Link: https://github.com/Ringman3640/ConsoleMenu
+//------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdio>
+#include "consolemenu.h"
+
+const int BOX_COUNT = 10000;
+const int FRAMES = 100;
+const int CLICKS = 1000;
+
+typedef std::chrono::steady_clock Clock;
+
+double elapsedMs(Clock::time_point start) {
+	std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+	return elapsed.count();
+}
+
+void buildAppended(conu::VertContainer& container) {
+	conu::TextBox item(10, 1, "item");
+	for (int i = 0; i < BOX_COUNT; ++i) {
+		container.insert(item);
+	}
+}
+
+void buildDescending(conu::VertContainer& container) {
+	conu::TextBox item(10, 1, "item");
+	for (int layer = BOX_COUNT; layer > 0; --layer) {
+		container.insert(layer, item);
+	}
+}
+
+void run(const char* name, void (*build)(conu::VertContainer&)) {
+	conu::ConsoleEditor& console = conu::ConsoleEditor::getInstance();
+	conu::Boundary winBound = console.getWindowBoundary();
+	conu::VertContainer container(conu::MAXIMUM, conu::MAXIMUM);
+
+	Clock::time_point start = Clock::now();
+	build(container);
+	double buildTime = elapsedMs(start);
+
+	container.buffer(conu::Position{ 0, 0 }, winBound);
+	start = Clock::now();
+	for (int i = 0; i < FRAMES; ++i) {
+		container.buffer(conu::Position{ 0, 0 }, winBound);
+	}
+	double frameTime = elapsedMs(start) / FRAMES;
+
+	conu::inputEvent::MouseEvent click{ };
+	click.eventFlag = conu::inputEvent::Mouse::CLICKED;
+	click.leftClick = true;
+	start = Clock::now();
+	for (int i = 0; i < CLICKS; ++i) {
+		click.mousePosition = conu::Position{ 2, i % winBound.bottom };
+		container.interact(click);
+	}
+	double clickTime = elapsedMs(start) * 1000 / CLICKS;
+
+	start = Clock::now();
+	for (int layer = 1; layer <= BOX_COUNT; ++layer) {
+		container.remove(layer);
+	}
+	double removeTime = elapsedMs(start);
+
+	std::printf("%-10s build %8.2f ms, frame %7.3f ms, click %7.2f us, "
+			"remove all %8.2f ms\n", name, buildTime, frameTime, clickTime,
+			removeTime);
+}
+
+int main() {
+	std::printf("%d TextBoxes in a VertContainer\n", BOX_COUNT);
+	run("Appended", buildAppended);
+	run("Descending", buildDescending);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+// keystrokereplay.cpp
+// Benchmark for typing into an EntryTextBox through replayed keystrokes.
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Program Description: Enters a Menu that holds a single EntryTextBox with
+//     auto print disabled and menu refreshing enabled, then replays keystrokes
+//     into the console input buffer from a second thread. A burst of
+//     keystrokes measures typing throughput and how many frames the refreshes
+//     are coalesced into. Keystrokes replayed one at a time measure the latency
+//     from a keystroke entering the input buffer to the frame that shows it,
+//     with and without a mouse movement queued behind each keystroke.
+//
+// Dependencies: ConsoleMenu Library
+//     Library Link: https://github.com/Ringman3640/ConsoleMenu
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Windows.h>
+#include "consolemenu.h"
+
+const int BURST_KEYS = 2000;
+const int PACED_KEYS = 200;
+
+typedef std::chrono::steady_clock Clock;
+
+// EntryTextBox that records how much of its input was shown by each print
+class ReplayEntry : public conu::EntryTextBox {
+public:
+	ReplayEntry(int width, int height) :
+		EntryTextBox(width, height) {
+
+	}
+
+	std::atomic<int> frames{ 0 };
+	std::atomic<int> shownLength{ 0 };
+
+protected:
+	virtual conu::Reply printProtocol(conu::Position pos,
+			conu::Boundary container, bool drawMode) override {
+		conu::Reply reply = EntryTextBox::printProtocol(pos, container,
+				drawMode);
+		shownLength = (int)getInput().size();
+		++frames;
+		return reply;
+	}
+
+};
+
+void writeRecords(const std::vector<INPUT_RECORD>& records) {
+	DWORD written = 0;
+	WriteConsoleInputA(GetStdHandle(STD_INPUT_HANDLE), records.data(),
+			(DWORD)records.size(), &written);
+}
+
+void addKey(std::vector<INPUT_RECORD>& records, char character) {
+	for (int down = 1; down >= 0; --down) {
+		INPUT_RECORD record = { };
+		record.EventType = KEY_EVENT;
+		record.Event.KeyEvent.bKeyDown = down;
+		record.Event.KeyEvent.wRepeatCount = 1;
+		record.Event.KeyEvent.uChar.AsciiChar = character;
+		records.push_back(record);
+	}
+}
+
+void addMouse(std::vector<INPUT_RECORD>& records, conu::Position pos,
+		DWORD buttonState, DWORD eventFlags) {
+	INPUT_RECORD record = { };
+	record.EventType = MOUSE_EVENT;
+	record.Event.MouseEvent.dwMousePosition = COORD{ (SHORT)pos.col,
+			(SHORT)pos.row };
+	record.Event.MouseEvent.dwButtonState = buttonState;
+	record.Event.MouseEvent.dwEventFlags = eventFlags;
+	records.push_back(record);
+}
+
+void waitFor(const std::atomic<int>& value, int target) {
+	while (value < target) {
+		std::this_thread::yield();
+	}
+}
+
+void replayPaced(ReplayEntry& entry, bool trailingMove, int& typed) {
+	std::vector<double> latencies;
+	conu::Position movePos = entry.getPosition();
+	for (int i = 0; i < PACED_KEYS; ++i) {
+		std::vector<INPUT_RECORD> records;
+		addKey(records, 'a' + i % 26);
+		if (trailingMove) {
+			addMouse(records, movePos, 0, MOUSE_MOVED);
+		}
+
+		auto start = Clock::now();
+		writeRecords(records);
+		waitFor(entry.shownLength, ++typed);
+		std::chrono::duration<double, std::micro> elapsed
+				= Clock::now() - start;
+		latencies.push_back(elapsed.count());
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	double total = 0;
+	for (double latency : latencies) {
+		total += latency;
+	}
+	std::printf("Paced%s: mean %.1f us, p50 %.1f us, p99 %.1f us, "
+			"max %.1f us\n", trailingMove ? " + mouse move" : "",
+			total / latencies.size(), latencies[latencies.size() / 2],
+			latencies[latencies.size() * 99 / 100], latencies.back());
+}
+
+void replay(conu::Menu& menu, ReplayEntry& entry) {
+	// Click the EntryTextBox once the Menu printed it to give it focus
+	waitFor(entry.frames, 1);
+	std::vector<INPUT_RECORD> records;
+	addMouse(records, entry.getPosition(), FROM_LEFT_1ST_BUTTON_PRESSED, 0);
+	writeRecords(records);
+	records.clear();
+
+	// Burst of keystrokes queued at once
+	for (int i = 0; i < BURST_KEYS; ++i) {
+		addKey(records, 'a' + i % 26);
+	}
+	int framesBefore = entry.frames;
+	auto start = Clock::now();
+	writeRecords(records);
+	waitFor(entry.shownLength, BURST_KEYS);
+	std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+	std::printf("Burst: %d keystrokes in %.2f ms (%.0f keystrokes/s), "
+			"%d frames\n", BURST_KEYS, elapsed.count(),
+			BURST_KEYS / (elapsed.count() / 1000), entry.frames - framesBefore);
+
+	int typed = BURST_KEYS;
+	replayPaced(entry, false, typed);
+	replayPaced(entry, true, typed);
+
+	// Submit the input to exit the Menu
+	records.clear();
+	addKey(records, (char)13);
+	writeRecords(records);
+}
+
+int main() {
+	conu::Menu menu;
+	conu::MenuOptions options = menu.getOptions();
+	options.useAutoPrint = false;
+	menu.setOptions(options);
+
+	ReplayEntry& entry = menu.emplace<ReplayEntry>(60, 3);
+	entry.setBorderSize(1);
+	entry.autoMenuRefreshing(true);
+	entry.setProcessHandler([&menu](std::string&) {
+		menu.exit();
+	});
+
+	std::thread replayer(replay, std::ref(menu), std::ref(entry));
+	menu.enter();
+	replayer.join();
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+// nestedcontainers.cpp
+// Benchmark for measuring and buffering nested dynamically sized containers.
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Program Description: Builds 6 levels of dynamically sized containers that
+//     alternate between VertContainers and HorizContainers, with 3 Boxes in
+//     each container and 729 TextBoxes at the bottom level. Times measuring
+//     the root container and buffering frames, both with nothing changed and
+//     with one of the deepest TextBoxes resized so that the measured size of
+//     every container above it is discarded.
+//
+// Dependencies: ConsoleMenu Library
+//     Library Link: https://github.com/Ringman3640/ConsoleMenu
+//------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdio>
+#include "consolemenu.h"
+
+const int LEVELS = 6;
+const int FANOUT = 3;
+const int FRAMES = 200;
+const int MEASURES = 20000;
+
+typedef std::chrono::steady_clock Clock;
+
+// Build a dynamically sized container of the given level by copying a
+// container of the level below
+conu::BoxContainer* buildLevel(int level) {
+	conu::BoxContainer* container = nullptr;
+	if (level % 2 == 0) {
+		container = new conu::VertContainer();
+	}
+	else {
+		container = new conu::HorizContainer();
+	}
+	container->dynamicallySized(true);
+
+	if (level == LEVELS - 1) {
+		for (int i = 0; i < FANOUT; ++i) {
+			container->insert(conu::TextBox(6, 1, "item"));
+		}
+		return container;
+	}
+
+	conu::BoxContainer* child = buildLevel(level + 1);
+	for (int i = 0; i < FANOUT; ++i) {
+		container->insert(*child);
+	}
+	delete child;
+	return container;
+}
+
+double bufferFrames(conu::BoxContainer& root, conu::Box* leaf, int frames) {
+	conu::ConsoleEditor& console = conu::ConsoleEditor::getInstance();
+	conu::Boundary winBound = console.getWindowBoundary();
+
+	auto start = Clock::now();
+	for (int i = 0; i < frames; ++i) {
+		if (leaf != nullptr) {
+			leaf->setDimensions(6 + i % 2, 1);
+		}
+		root.buffer(conu::Position{ 0, 0 }, winBound);
+	}
+	std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+	return elapsed.count() / frames;
+}
+
+int main() {
+	conu::BoxContainer* root = buildLevel(0);
+
+	// Find one of the deepest TextBoxes
+	conu::Box* leaf = root;
+	for (int level = 0; level < LEVELS; ++level) {
+		leaf = static_cast<conu::BoxContainer*>(leaf)->get(1);
+	}
+
+	auto start = Clock::now();
+	long long checksum = 0;
+	for (int i = 0; i < MEASURES; ++i) {
+		checksum += root->getWidth() + root->getHeight();
+	}
+	std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+	std::printf("%d levels, %d Boxes per container, root is %dx%d\n", LEVELS,
+			FANOUT, root->getWidth(), root->getHeight());
+	std::printf("Measure root:          %10.3f us/call (checksum %lld)\n",
+			elapsed.count() / MEASURES, checksum);
+
+	start = Clock::now();
+	for (int i = 0; i < MEASURES; ++i) {
+		leaf->setDimensions(6 + i % 2, 1);
+		checksum += root->getWidth() + root->getHeight();
+	}
+	elapsed = Clock::now() - start;
+	std::printf("Measure after resize:  %10.3f us/call (checksum %lld)\n",
+			elapsed.count() / MEASURES, checksum);
+
+	bufferFrames(*root, nullptr, FRAMES / 10);
+	std::printf("Buffer, no changes:    %10.3f ms/frame\n",
+			bufferFrames(*root, nullptr, FRAMES));
+	std::printf("Buffer, resized leaf:  %10.3f ms/frame\n",
+			bufferFrames(*root, leaf, FRAMES));
+
+	delete root;
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+// painterprimitives.cpp
+// Micro-benchmarks for each GraphicPainter primitive on a 200x60 Graphic.
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Program Description: Times each drawing primitive of a GraphicPainter on a
+//     200x60 Graphic, repeating every primitive and reporting the average
+//     time of one call. Lines, circles, and ellipses are drawn both within the
+//     canvas and as huge shapes of which only a small part crosses the canvas.
+//     The Graphic is never buffered or written to the console.
+//
+// Dependencies: ConsoleMenu Library
+//     Library Link: https://github.com/Ringman3640/ConsoleMenu
+//------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdio>
+#include "consolemenu.h"
+
+const int CANVAS_WIDTH = 200;
+const int CANVAS_HEIGHT = 60;
+const int REPEATS = 2000;
+const int HUGE_RADIUS = 100000;
+
+typedef std::chrono::steady_clock Clock;
+
+conu::Graphic graphic(CANVAS_WIDTH, CANVAS_HEIGHT);
+conu::GraphicPainter painter(graphic);
+
+// Call a primitive REPEATS times with an alternating brush and print the
+// average time of one call
+void timeCall(const char* name, void (*draw)(char brush)) {
+	graphic.clear();
+	draw('a');
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < REPEATS; ++i) {
+		draw(i % 2 == 0 ? 'b' : 'a');
+	}
+	std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+	std::printf("%-32s %10.2f us\n", name, elapsed.count() / REPEATS);
+}
+
+int main() {
+	std::printf("%dx%d canvas, %d calls each\n", CANVAS_WIDTH, CANVAS_HEIGHT,
+			REPEATS);
+
+	timeCall("drawLine, within canvas", [](char brush) {
+		painter.drawLine(conu::Position{ 0, 0 },
+				conu::Position{ CANVAS_WIDTH - 1, CANVAS_HEIGHT - 1 }, brush);
+	});
+	timeCall("drawLine, mostly off canvas", [](char brush) {
+		painter.drawLine(conu::Position{ -HUGE_RADIUS, -HUGE_RADIUS / 4 },
+				conu::Position{ HUGE_RADIUS, HUGE_RADIUS / 4 }, brush);
+	});
+	timeCall("drawRect", [](char brush) {
+		painter.drawRect(conu::Boundary{ 10, 5, CANVAS_WIDTH - 11,
+				CANVAS_HEIGHT - 6 }, brush);
+	});
+	timeCall("fillRect", [](char brush) {
+		painter.fillRect(conu::Boundary{ 10, 5, CANVAS_WIDTH - 11,
+				CANVAS_HEIGHT - 6 }, brush);
+	});
+	timeCall("drawEllipse", [](char brush) {
+		painter.drawEllipse(conu::Boundary{ 10, 5, CANVAS_WIDTH - 11,
+				CANVAS_HEIGHT - 6 }, brush);
+	});
+	timeCall("fillEllipse", [](char brush) {
+		painter.fillEllipse(conu::Boundary{ 10, 5, CANVAS_WIDTH - 11,
+				CANVAS_HEIGHT - 6 }, brush);
+	});
+	timeCall("drawCircle", [](char brush) {
+		painter.drawCircle(conu::Position{ CANVAS_WIDTH / 2,
+				CANVAS_HEIGHT / 2 }, CANVAS_HEIGHT / 2 - 1, brush);
+	});
+	timeCall("fillCircle", [](char brush) {
+		painter.fillCircle(conu::Position{ CANVAS_WIDTH / 2,
+				CANVAS_HEIGHT / 2 }, CANVAS_HEIGHT / 2 - 1, brush);
+	});
+	timeCall("drawCircle, huge radius", [](char brush) {
+		painter.drawCircle(conu::Position{ CANVAS_WIDTH / 2,
+				HUGE_RADIUS + CANVAS_HEIGHT / 2 }, HUGE_RADIUS, brush);
+	});
+	timeCall("fillCircle, huge radius", [](char brush) {
+		painter.fillCircle(conu::Position{ CANVAS_WIDTH / 2,
+				HUGE_RADIUS + CANVAS_HEIGHT / 2 }, HUGE_RADIUS, brush);
+	});
+	timeCall("floodFill, whole canvas", [](char brush) {
+		painter.floodFill(conu::Position{ 0, 0 }, brush);
+	});
+	timeCall("copyRect", [](char) {
+		painter.copyRect(conu::Boundary{ 0, 0, CANVAS_WIDTH / 2 - 1,
+				CANVAS_HEIGHT - 1 }, conu::Position{ CANVAS_WIDTH / 2, 0 });
+	});
+	timeCall("moveRect", [](char brush) {
+		painter.moveRect(conu::Boundary{ 0, 0, CANVAS_WIDTH - 2,
+				CANVAS_HEIGHT - 2 }, conu::Position{ 1, 1 }, brush);
+	});
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+// parallelbuffer.cpp
+// Benchmark for buffering a large dashboard with the RenderPool.
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Program Description: Builds a 300x100 dashboard of 20 rows of 12 bordered
+//     TextBoxes and times buffering it into the write buffer with 1, 2, 4,
+//     and 8 RenderPool threads. The frame is never written to the console,
+//     so only the rasterization of the contained Boxes is measured.
+//
+// Dependencies: ConsoleMenu Library
+//     Library Link: https://github.com/Ringman3640/ConsoleMenu
+//------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include "consolemenu.h"
+
+const int ROWS = 20;
+const int COLS = 12;
+const int CELL_WIDTH = 25;
+const int CELL_HEIGHT = 5;
+const int FRAMES = 500;
+
+double bufferFrames(conu::VertContainer& dashboard, int frames) {
+	conu::ConsoleEditor& console = conu::ConsoleEditor::getInstance();
+	conu::Boundary winBound = console.getWindowBoundary();
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < frames; ++i) {
+		console.lockWriteBuffer();
+		dashboard.buffer(conu::Position{ 0, 0 }, winBound);
+		console.unlockWriteBuffer();
+		conu::BoxContainer::endFrame();
+	}
+	std::chrono::duration<double, std::milli> elapsed
+			= std::chrono::steady_clock::now() - start;
+	return elapsed.count() / frames;
+}
+
+int main() {
+	conu::ConsoleEditor& console = conu::ConsoleEditor::getInstance();
+	console.setWindowDimensions(COLS * CELL_WIDTH, ROWS * CELL_HEIGHT);
+
+	conu::VertContainer dashboard(COLS * CELL_WIDTH, ROWS * CELL_HEIGHT);
+	for (int row = 0; row < ROWS; ++row) {
+		conu::HorizContainer& line = dashboard.emplace<conu::HorizContainer>(
+				COLS * CELL_WIDTH, CELL_HEIGHT);
+		for (int col = 0; col < COLS; ++col) {
+			conu::TextBox& cell = line.emplace<conu::TextBox>(CELL_WIDTH,
+					CELL_HEIGHT, "Sensor " + std::to_string(row * COLS + col)
+					+ " reading 42.0 units within range");
+			cell.setBorderSize(1);
+		}
+	}
+
+	conu::Position winDim = console.getWindowDimensions();
+	std::printf("Dashboard of %d TextBoxes in a %dx%d window, %d frames\n",
+			ROWS * COLS, winDim.col, winDim.row, FRAMES);
+	std::printf("Hardware threads: %u\n",
+			std::thread::hardware_concurrency());
+
+	conu::RenderPool& pool = conu::RenderPool::getInstance();
+	double serial = 0;
+	int threadCounts[] = { 1, 2, 4, 8 };
+	for (int threads : threadCounts) {
+		pool.setThreadCount(threads);
+		bufferFrames(dashboard, FRAMES / 10);
+		double frameTime = bufferFrames(dashboard, FRAMES);
+		if (threads == 1) {
+			serial = frameTime;
+		}
+		std::printf("%d thread(s): %8.3f ms/frame  %5.2fx\n", threads,
+				frameTime, serial / frameTime);
+	}
+	pool.setThreadCount(1);
+
+	return 0;
+}
\ No newline at end of file
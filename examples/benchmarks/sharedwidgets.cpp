@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+// sharedwidgets.cpp
+// Memory report for 5 thousand copies of a widget with shared content data.
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Program Description: Builds a widget of a HorizContainer that holds a
+//     bordered TextBox with a paragraph of text and a 24x6 Graphic icon, then
+//     inserts 5 thousand copies of it into a VertContainer. Reports the heap
+//     memory held per widget after the copies are made, after a frame is
+//     buffered, and after every copy has been edited so that it owns its
+//     content data. Heap memory is counted by replacing the global allocation
+//     functions.
+//
+// Dependencies: ConsoleMenu Library
+//     Library Link: https://github.com/Ringman3640/ConsoleMenu
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "consolemenu.h"
+
+const int WIDGETS = 5000;
+const int ICON_WIDTH = 24;
+const int ICON_HEIGHT = 6;
+const char* LABEL_TEXT = "Reactor coolant loop B. Flow, pressure, and "
+		"temperature are sampled every second and averaged over the last "
+		"minute. Values outside the configured range raise an alarm on this "
+		"panel.";
+
+// Bytes currently allocated from the free store
+std::atomic<long long> heapBytes{ 0 };
+
+// Each allocation is prefixed with its size so that it can be subtracted when
+// the allocation is freed
+void* operator new(std::size_t size) {
+	std::size_t* region = static_cast<std::size_t*>(
+			std::malloc(size + alignof(std::max_align_t)));
+	if (region == nullptr) {
+		throw std::bad_alloc();
+	}
+	*region = size;
+	heapBytes += size;
+	return reinterpret_cast<char*>(region) + alignof(std::max_align_t);
+}
+
+void operator delete(void* ptr) noexcept {
+	if (ptr == nullptr) {
+		return;
+	}
+	std::size_t* region = reinterpret_cast<std::size_t*>(
+			static_cast<char*>(ptr) - alignof(std::max_align_t));
+	heapBytes -= *region;
+	std::free(region);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	operator delete(ptr);
+}
+
+void report(const char* step, long long baseline) {
+	long long bytes = heapBytes - baseline;
+	std::printf("%-28s %10lld bytes, %7.1f bytes/widget\n", step, bytes,
+			(double)bytes / WIDGETS);
+}
+
+int main() {
+	conu::ConsoleEditor& console = conu::ConsoleEditor::getInstance();
+	conu::Boundary winBound = console.getWindowBoundary();
+
+	conu::HorizContainer widget(70, ICON_HEIGHT);
+	conu::TextBox& label = widget.emplace<conu::TextBox>(46, ICON_HEIGHT,
+			LABEL_TEXT);
+	label.setBorderSize(1);
+	conu::Graphic& icon = widget.emplace<conu::Graphic>(ICON_WIDTH,
+			ICON_HEIGHT);
+	for (int row = 0; row < ICON_HEIGHT; ++row) {
+		icon[row] = "<=>---<=>---<=>---<=>---";
+	}
+
+	long long baseline = heapBytes;
+	conu::VertContainer list(conu::MAXIMUM, conu::MAXIMUM);
+	for (int i = 0; i < WIDGETS; ++i) {
+		list.insert(widget);
+	}
+	std::printf("%d widgets\n", WIDGETS);
+	report("Copied", baseline);
+
+	list.buffer(conu::Position{ 0, 0 }, winBound);
+	report("After one buffered frame", baseline);
+
+	// Rewrite the content of every copy with the same value so that each copy
+	// owns its content data
+	for (int i = 1; i <= WIDGETS; ++i) {
+		conu::HorizContainer& copy = static_cast<conu::HorizContainer&>(
+				*list.get(i));
+		conu::TextBox& copyLabel = static_cast<conu::TextBox&>(*copy.get(1));
+		copyLabel.setText(LABEL_TEXT);
+		conu::Graphic& copyIcon = static_cast<conu::Graphic&>(*copy.get(2));
+		copyIcon[0] = copyIcon[0].getString();
+	}
+	report("Every copy edited", baseline);
+
+	return 0;
+}
\ No newline at end of file
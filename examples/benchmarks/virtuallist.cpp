@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+// virtuallist.cpp
+// Benchmark for buffering VirtualContainer lists of growing item counts.
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Program Description: Buffers an 80x50 VirtualContainer of TextBox rows that
+//     lists 1 thousand to 1 million items, and times frames where the list is
+//     unchanged, scrolled by a single row, and jumped to a random position.
+//     Unchanged frames are also timed for a VertContainer that holds a TextBox
+//     for every item, up to 10 thousand items.
+//
+// Dependencies: ConsoleMenu Library
+//     Library Link: https://github.com/Ringman3640/ConsoleMenu
+//------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include "consolemenu.h"
+
+const int LIST_WIDTH = 80;
+const int LIST_HEIGHT = 50;
+const int FRAMES = 500;
+const int EAGER_MAX_ITEMS = 10000;
+
+typedef std::chrono::steady_clock Clock;
+
+enum class Motion {
+	NONE,
+	STEP,
+	JUMP
+};
+
+// Time frames of a list, scrolling the list before each frame by passing the
+// new first visible item to a scroll routine.
+double bufferFrames(conu::Box& list, int itemCount, Motion motion,
+		const std::function<void(int)>& scrollTo) {
+	conu::ConsoleEditor& console = conu::ConsoleEditor::getInstance();
+	conu::Boundary winBound = console.getWindowBoundary();
+	std::mt19937 random(7);
+	std::uniform_int_distribution<int> items(0, itemCount - LIST_HEIGHT);
+
+	auto start = Clock::now();
+	for (int i = 0; i < FRAMES; ++i) {
+		if (motion == Motion::STEP) {
+			scrollTo(i % (itemCount - LIST_HEIGHT));
+		}
+		else if (motion == Motion::JUMP) {
+			scrollTo(items(random));
+		}
+		list.buffer(conu::Position{ 0, 0 }, winBound);
+	}
+	std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+	return elapsed.count() / FRAMES;
+}
+
+// Report the frame times of a list. Lists without a scroll routine only time
+// unchanged frames.
+void report(const char* name, int itemCount, conu::Box& list,
+		const std::function<void(int)>& scrollTo) {
+	bufferFrames(list, itemCount, Motion::NONE, scrollTo);
+	double still = bufferFrames(list, itemCount, Motion::NONE, scrollTo);
+	if (!scrollTo) {
+		std::printf("%-16s %8d items: %9.1f us still\n", name, itemCount,
+				still);
+		return;
+	}
+
+	double step = bufferFrames(list, itemCount, Motion::STEP, scrollTo);
+	double jump = bufferFrames(list, itemCount, Motion::JUMP, scrollTo);
+	std::printf("%-16s %8d items: %9.1f us still, %9.1f us step, "
+			"%9.1f us jump\n", name, itemCount, still, step, jump);
+}
+
+int main() {
+	int itemCounts[] = { 1000, 10000, 100000, 1000000 };
+	for (int itemCount : itemCounts) {
+		conu::VirtualContainer list(LIST_WIDTH, LIST_HEIGHT);
+		list.setRowTemplate(conu::TextBox());
+		list.setRowBinder([](conu::Box& row, int item) {
+			static_cast<conu::TextBox&>(row).setText("Item "
+					+ std::to_string(item));
+		});
+		list.setItemCount(itemCount);
+		report("VirtualContainer", itemCount, list, [&list](int item) {
+			list.setScrollPosition(item);
+		});
+	}
+
+	// A VertContainer cannot scroll, so only unchanged frames are timed
+	for (int itemCount : itemCounts) {
+		if (itemCount > EAGER_MAX_ITEMS) {
+			break;
+		}
+
+		conu::VertContainer list(LIST_WIDTH, LIST_HEIGHT);
+		for (int item = 0; item < itemCount; ++item) {
+			list.insert(conu::TextBox(LIST_WIDTH, 1, "Item "
+					+ std::to_string(item)));
+		}
+		report("VertContainer", itemCount, list, nullptr);
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -14,10 +14,15 @@
 
 #pragma once
 
-#include <map>
 #include <vector>
 #include <algorithm>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <type_traits>
 #include "Box/box.h"
+#include "Box/BoxContainer/renderpool.h"
 
 namespace conu {
 
@@ -83,6 +88,15 @@ public:
     // Parameterized constructor
     BoxContainer(int width, int height);
 
+    //--------------------------------------------------------------------------
+    // Copy constructor. Performs a deep copy of the contained Boxes.
+    BoxContainer(const BoxContainer& copy);
+
+    //--------------------------------------------------------------------------
+    // Move constructor. Takes ownership of the contained Boxes without copying
+    // them, leaving the moved BoxContainer empty.
+    BoxContainer(BoxContainer&& move);
+
     //--------------------------------------------------------------------------
     // Virtual destructor
     virtual ~BoxContainer() override;
@@ -111,7 +125,8 @@ public:
     //--------------------------------------------------------------------------
     // Get the target height of the BoxContainer. If the BoxContainer is 
     // dynamically sized, it will get the maximum height the BoxContainer may
-    // become.
+    // become. The content size is measured once and cached until the layout
+    // is invalidated.
     virtual int getHeight() const;
 
     //--------------------------------------------------------------------------
@@ -121,7 +136,8 @@ public:
     //--------------------------------------------------------------------------
     // Get the target width of the BoxContainer. If the BoxContainer is 
     // dynamically sized, it will get the maximum width the BoxContainer may
-    // become.
+    // become. The content size is measured once and cached until the layout
+    // is invalidated.
     virtual int getWidth() const;
 
     //--------------------------------------------------------------------------
@@ -147,6 +163,44 @@ public:
     // by the inserted Box.
     virtual void insert(int layer, const Box& inBox, const Position& pos);
 
+    //--------------------------------------------------------------------------
+    // Construct a Box of type T in place at the next available layer
+    // incrementally starting from layer 1, forwarding the given arguments to
+    // its constructor. The Box is marked as "dynamic".
+    // Returns a reference to the constructed Box.
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args);
+
+    //--------------------------------------------------------------------------
+    // Insert an owned Box into the BoxContainer without copying it. Ownership
+    // is transferred to the BoxContainer. Follows the layer and position rules
+    // of the copying insert methods.
+    // Returns a reference to the inserted Box.
+    template <typename T>
+    T& insert(std::unique_ptr<T> inBox);
+    template <typename T>
+    T& insert(int layer, std::unique_ptr<T> inBox);
+    template <typename T>
+    T& insert(int layer, std::unique_ptr<T> inBox, const Position& pos);
+
+    //--------------------------------------------------------------------------
+    // Insert a temporary Box into the BoxContainer by moving it instead of
+    // copying it. Follows the layer and position rules of the copying insert
+    // methods.
+    // Returns a reference to the inserted Box.
+    template <typename T, typename = typename std::enable_if<
+            std::is_base_of<Box, T>::value
+            && !std::is_lvalue_reference<T>::value>::type>
+    T& insert(T&& inBox);
+    template <typename T, typename = typename std::enable_if<
+            std::is_base_of<Box, T>::value
+            && !std::is_lvalue_reference<T>::value>::type>
+    T& insert(int layer, T&& inBox);
+    template <typename T, typename = typename std::enable_if<
+            std::is_base_of<Box, T>::value
+            && !std::is_lvalue_reference<T>::value>::type>
+    T& insert(int layer, T&& inBox, const Position& pos);
+
     //--------------------------------------------------------------------------
     // Remove a Box from the BoxContainer at a specified layer. 
     virtual void remove(int layer);
@@ -174,25 +228,77 @@ public:
     // Set the content distribution of the BoxContainer.
     void setDistribution(BoxDistrib distribution);
 
+    //--------------------------------------------------------------------------
+    // Set the alignment of the BoxContainer contents.
+    virtual void setAlignment(Align inAlign) override;
+
+    //--------------------------------------------------------------------------
+    // Mark the end of a printed frame, storing the per-frame counters of the
+    // frame and resetting them for the next frame. Called by Menu::print().
+    static void endFrame();
+
+    //--------------------------------------------------------------------------
+    // Get the amount of contained Boxes that were culled during the previous
+    // frame. A Box is culled if it does not fit within the visible content
+    // boundary of its BoxContainer, in which case it is not printed.
+    static int getCulledCount();
+
+    //--------------------------------------------------------------------------
+    // Get the amount of contained Boxes that were occluded during the previous
+    // frame. A Box is occluded if every cell it would print is covered by
+    // opaque Boxes printed after it, in which case it is not printed.
+    static int getOccludedCount();
+
+    //--------------------------------------------------------------------------
+    // Get the overdraw of the previous frame: the average amount of times each
+    // cell of the console window was written to.
+    static double getOverdraw();
+
 protected:
     //--------------------------------------------------------------------------
     // BoxItem structure
     // Contains information about an internal Box within the BoxContainer, such
-    // as if the Box is fixed at a set position, and the position of the Box
-    // if it is fixed.
+    // as its layer, if the Box is fixed at a set position, and the position of
+    // the Box if it is fixed.
     struct BoxItem {
+        int layer;
         Box* item;
         bool fixed;
         Position pos;
     };
 
-    std::map<int, BoxItem> contents;
+    //--------------------------------------------------------------------------
+    // ItemPlacement structure
+    // Contains a contained Box and the position it is printed at during the
+    // current print.
+    struct ItemPlacement {
+        Box* item;
+        Position pos;
+    };
+
+    // Contained Boxes sorted by ascending layer
+    std::vector<BoxItem> contents;
     Box* recent;
     BoxDistrib distribution;
     int returnHeight;
     int returnWidth;
     bool dynamicSized;
 
+    // Cached content size used by getHeight() and getWidth()
+    mutable bool measureValid;
+    mutable int measuredHeight;
+    mutable int measuredWidth;
+
+    // Stored arrangement of the contents from the previous layout pass and
+    // the constraints it was arranged with
+    std::vector<ItemPlacement> arrangement;
+    Boundary arrangedBound;
+    Position arrangedOrigin;
+    Position arrangedPos;
+    int arrangedWidth;
+    int arrangedHeight;
+    bool arrangeValid;
+
     //--------------------------------------------------------------------------
     // The protocol used to print the Box object to the screen or buffer
     // (indicated by the drawMode parameter). Each derived class of Box should
@@ -201,6 +307,56 @@ protected:
     virtual Reply printProtocol(Position pos, Boundary container,
             bool drawMode) = 0;
 
+    //--------------------------------------------------------------------------
+    // Discard the cached content size of the BoxContainer. Returns true if the
+    // content size was cached.
+    virtual bool discardMeasure() override;
+
+    //--------------------------------------------------------------------------
+    // Measure and cache the content size of the BoxContainer if the cached
+    // size is invalid.
+    void measure() const;
+
+    //--------------------------------------------------------------------------
+    // Run the layout pass of the BoxContainer given the origin position passed
+    // to printProtocol(). The contents are only arranged again if the stored
+    // arrangement was invalidated or if the position or actual dimensions of
+    // the BoxContainer changed.
+    // Assumes that the actual dimensions and position of the BoxContainer
+    // have been calculated.
+    void layout(const Position& pos);
+
+    //--------------------------------------------------------------------------
+    // Arrange the contents of the BoxContainer within the content boundary by
+    // storing the print position of each content Box in arrangement, in print
+    // order.
+    // Helper method for layout().
+    virtual void arrangeContents(const Position& pos,
+            const Boundary& contentBound) = 0;
+
+    //--------------------------------------------------------------------------
+    // Get an iterator to the first BoxItem with a layer that is not less than
+    // the given layer.
+    std::vector<BoxItem>::iterator findLayer(int layer);
+    std::vector<BoxItem>::const_iterator findLayer(int layer) const;
+
+    //--------------------------------------------------------------------------
+    // Get the first layer starting from layer 1 that is not occupied by a
+    // BoxItem. Constant time if layers 1 and up are occupied without gaps;
+    // otherwise logarithmic time.
+    int nextFreeLayer() const;
+
+    //--------------------------------------------------------------------------
+    // Place a BoxItem into the contents at its layer, replacing and freeing any
+    // BoxItem at the same layer. Appending past the last layer is constant
+    // time.
+    void placeItem(const BoxItem& inItem);
+
+    //--------------------------------------------------------------------------
+    // Take ownership of an inserted Box by linking the Box to the BoxContainer
+    // as its parent.
+    void adopt(Box* item);
+
     //--------------------------------------------------------------------------
     // Get the content boundary of the BoxContainer (accounting for horizontal
     // and vertical border sizes) given the position of the BoxContainer.
@@ -212,10 +368,113 @@ protected:
     std::vector<int> getSpacingHeight(const Boundary& container,
         int totalHeight, int dynamCount) const;
 
+    //--------------------------------------------------------------------------
+    // Print the base of the BoxContainer and the stored arrangement of its
+    // contents. Contained Boxes that do not fit within the visible content
+    // boundary are culled, and Boxes that are fully covered by opaque Boxes
+    // printed after them are occluded. Only Boxes that are not transparent
+    // and flagged with opaqueBase are opaque. Interior rows of the base that are
+    // fully covered by opaque Boxes are not painted. The actual dimensions and
+    // position of the BoxContainer must be calculated and layout() must be
+    // called beforehand.
+    void printContents(bool drawMode);
+
+    //--------------------------------------------------------------------------
+    // Get the placements of a list of contained Boxes that are neither culled
+    // nor occluded, along with the rect each Box covers within the visible
+    // content boundary. Cells of the BoxContainer (indexed row by row from
+    // its top-left cell) that are covered by opaque Boxes are flagged in
+    // coveredCells.
+    // Helper method for printContents().
+    void cullItems(const std::vector<ItemPlacement>& placements,
+            const Boundary& contentBound, std::vector<ItemPlacement>& visible,
+            std::vector<Boundary>& visibleRects,
+            std::vector<char>& coveredCells);
+
+    //--------------------------------------------------------------------------
+    // Print a list of visible contained Boxes in list order within the content
+    // boundary. When buffering a frame held through 
+    // ConsoleEditor::lockWriteBuffer(), consecutive Boxes that do not overlap
+    // are buffered in parallel on the RenderPool.
+    // Helper method for printContents().
+    void printItems(const std::vector<ItemPlacement>& visible,
+            const std::vector<Boundary>& visibleRects,
+            const Boundary& contentBound, bool drawMode);
+
     //--------------------------------------------------------------------------
     // Clear the BoxContainer contents and free all allocated memory.
     void clearContents();
 
+private:
+    // Minimum amount of Boxes printed by a BoxContainer before the RenderPool
+    // is used.
+    static const unsigned PARALLEL_MIN_ITEMS;
+
+    // Culled and occluded Box counts of the current and previous frame
+    static std::atomic<int> culledCount;
+    static std::atomic<int> frameCulledCount;
+    static std::atomic<int> occludedCount;
+    static std::atomic<int> frameOccludedCount;
+
+    // Overdraw of the previous frame
+    static std::atomic<double> frameOverdraw;
+
+    //--------------------------------------------------------------------------
+    // Check if two rectangles share any cell.
+    // Helper method for printItems().
+    static bool rectsOverlap(const Boundary& first, const Boundary& second);
+
 };
+//------------------------------------------------------------------------------
+template <typename T, typename... Args>
+T& BoxContainer::emplace(Args&&... args) {
+    return insert(std::unique_ptr<T>(new T(std::forward<Args>(args)...)));
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+T& BoxContainer::insert(std::unique_ptr<T> inBox) {
+    T& item = *inBox;
+    recent = inBox.release();
+    placeItem(BoxItem{ nextFreeLayer(), recent, false, Position{-1, -1} });
+    return item;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+T& BoxContainer::insert(int layer, std::unique_ptr<T> inBox) {
+    T& item = *inBox;
+    recent = inBox.release();
+    placeItem(BoxItem{ layer, recent, false, Position{-1, -1} });
+    return item;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+T& BoxContainer::insert(int layer, std::unique_ptr<T> inBox,
+        const Position& pos) {
+    T& item = *inBox;
+    recent = inBox.release();
+    placeItem(BoxItem{ layer, recent, true, pos });
+    return item;
+}
+
+//------------------------------------------------------------------------------
+template <typename T, typename>
+T& BoxContainer::insert(T&& inBox) {
+    return insert(std::unique_ptr<T>(new T(std::move(inBox))));
+}
+
+//------------------------------------------------------------------------------
+template <typename T, typename>
+T& BoxContainer::insert(int layer, T&& inBox) {
+    return insert(layer, std::unique_ptr<T>(new T(std::move(inBox))));
+}
+
+//------------------------------------------------------------------------------
+template <typename T, typename>
+T& BoxContainer::insert(int layer, T&& inBox, const Position& pos) {
+    return insert(layer, std::unique_ptr<T>(new T(std::move(inBox))), pos);
+}
 
 }
@@ -32,6 +32,10 @@ public:
     // Copy constructor
     HorizContainer(const HorizContainer& cpy);
 
+    //--------------------------------------------------------------------------
+    // Move constructor
+    HorizContainer(HorizContainer&& move);
+
     //--------------------------------------------------------------------------
     // Recieve a MouseEvent and send it to the corresponding contained Box.
     virtual Reply interact(inputEvent::MouseEvent action) override;
@@ -66,6 +70,12 @@ private:
     virtual Reply printProtocol(Position pos, Boundary container,
             bool drawMode) override;
 
+    //--------------------------------------------------------------------------
+    // Arrange the contents of the HorizContainer within the content boundary
+    // according to its alignment and distribution.
+    virtual void arrangeContents(const Position& pos,
+            const Boundary& contentBound) override;
+
     //--------------------------------------------------------------------------
     // Get the spacing vector for content printed horizontally given the
     // content boundary, total width of the contents, and dynamic box count.
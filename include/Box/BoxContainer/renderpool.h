@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+// renderpool.h
+// Interface for the RenderPool class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: The RenderPool is a small pool of worker threads used by
+//     BoxContainers to buffer independent contained Boxes in parallel. A batch
+//     of jobs is submitted through run(), which blocks until every job in the
+//     batch has completed. The submitting thread executes jobs alongside the
+//     workers. Jobs that submit a batch of their own are executed serially to
+//     prevent the pool from waiting on itself. This class is implemented as a
+//     singleton; an instance must be aquired through the
+//     RenderPool::getInstance() method.
+// 
+// Dependencies: None.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+class RenderPool {
+public:
+    //--------------------------------------------------------------------------
+    // Destructor
+    ~RenderPool();
+
+    //--------------------------------------------------------------------------
+    // Get the singleton instance of the RenderPool class.
+    static RenderPool& getInstance();
+
+    //--------------------------------------------------------------------------
+    // Set the number of threads used to execute a batch, including the thread
+    // that submits the batch. A thread count of 1 executes every batch
+    // serially on the submitting thread. Defaults to 1, so BoxContainers only
+    // buffer in parallel once a larger thread count is set.
+    void setThreadCount(int count);
+
+    //--------------------------------------------------------------------------
+    // Get the number of threads used to execute a batch.
+    int getThreadCount() const;
+
+    //--------------------------------------------------------------------------
+    // Execute a batch of jobs across the pool. Blocks until all jobs in the
+    // batch have completed. Jobs may run in any order and at the same time.
+    void run(const std::vector<std::function<void()>>& jobs);
+
+    //--------------------------------------------------------------------------
+    // Check if the calling thread is currently executing a RenderPool job.
+    static bool onWorkerThread();
+
+private:
+    // Singleton static instance
+    static RenderPool instance;
+
+    // Indicates if the current thread is executing a batch job
+    static thread_local bool workerThread;
+
+    // Worker thread members
+    std::vector<std::thread> workers;
+    int threadCount;
+    bool terminateWorkers;
+
+    // Current batch information
+    const std::vector<std::function<void()>>* batch;
+    unsigned batchId;
+    std::atomic<unsigned> nextJob;
+    std::atomic<unsigned> remainingJobs;
+    int activeWorkers;
+
+    // Thread control
+    std::mutex runLock;
+    std::mutex poolLock;
+    std::condition_variable batchCV;
+    std::condition_variable doneCV;
+
+    //--------------------------------------------------------------------------
+    // Private constructor
+    RenderPool();
+
+    //--------------------------------------------------------------------------
+    // Worker thread function.
+    void worker();
+
+    //--------------------------------------------------------------------------
+    // Execute jobs from a batch until no unclaimed jobs remain.
+    void executeJobs(const std::vector<std::function<void()>>& jobs);
+
+    //--------------------------------------------------------------------------
+    // Launch the worker threads for the current thread count.
+    void startWorkers();
+
+    //--------------------------------------------------------------------------
+    // Terminate all running worker threads.
+    void stopWorkers();
+
+};
+
+}
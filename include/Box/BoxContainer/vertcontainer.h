@@ -32,6 +32,10 @@ public:
     // Copy constructor
     VertContainer(const VertContainer& cpy);
 
+    //--------------------------------------------------------------------------
+    // Move constructor
+    VertContainer(VertContainer&& move);
+
     //--------------------------------------------------------------------------
     // Recieve a MouseEvent and send it to the corresponding contained Box.
     virtual Reply interact(inputEvent::MouseEvent action) override;
@@ -66,6 +70,12 @@ private:
     virtual Reply printProtocol(Position pos, Boundary container,
             bool drawMode) override;
 
+    //--------------------------------------------------------------------------
+    // Arrange the contents of the VertContainer within the content boundary
+    // according to its alignment and distribution.
+    virtual void arrangeContents(const Position& pos,
+            const Boundary& contentBound) override;
+
     //--------------------------------------------------------------------------
     // Get the spacing vector for content printed vertically given the
     // content boundary, total height of the contents, and dynamic box count.
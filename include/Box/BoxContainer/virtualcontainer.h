@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+// virtualcontainer.h
+// Interface for the VirtualContainer class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: A VirtualContainer is a type of Box that displays a vertical
+//     list of a large amount of items. Instead of containing a Box for every
+//     item, the VirtualContainer only materializes a pool of row Boxes for the
+//     rows that are visible within its boundary. Row Boxes are copies of a
+//     user-defined row template and are recycled as the list is scrolled; a
+//     user-defined binder routine applies the data of an item to a row Box
+//     whenever the row is assigned a new item. The list can be scrolled using
+//     the mouse wheel.
+//
+// Dependencies: Box class.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <vector>
+#include <functional>
+#include "Box/box.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+class VirtualContainer : public Box {
+public:
+    //--------------------------------------------------------------------------
+    // Default constructor
+    VirtualContainer();
+
+    //--------------------------------------------------------------------------
+    // Parameterized constructor
+    VirtualContainer(int width, int height);
+
+    //--------------------------------------------------------------------------
+    // Copy constructor. The row pool of the copy is materialized on its first
+    // print.
+    VirtualContainer(const VirtualContainer& copy);
+
+    //--------------------------------------------------------------------------
+    // Copy assignment operator (deleted)
+    VirtualContainer& operator = (const VirtualContainer& copy) = delete;
+
+    //--------------------------------------------------------------------------
+    // Virtual destructor
+    virtual ~VirtualContainer() override;
+
+    //--------------------------------------------------------------------------
+    // Interact with the VirtualContainer given a MouseEvent. A MouseEvent that
+    // indicates a scroll will scroll the list by a single row. Any other
+    // MouseEvent is sent to the row Box under the mouse from the previous
+    // print.
+    // If the Box has not been drawn yet, FAILED is returned.
+    // If the MouseEvent is out-of-bounds, IGNORED is returned.
+    // If the list is scrolled, REFRESH is returned. Otherwise the Reply of the
+    // interacted row Box is returned.
+    virtual Reply interact(inputEvent::MouseEvent action) override;
+
+    //--------------------------------------------------------------------------
+    // Create a deep copy of this VirtualContainer object and return a pointer
+    // to that copy.
+    virtual Box* copyBox() const override;
+
+    //--------------------------------------------------------------------------
+    // Create a new VirtualContainer object and return a pointer to that object.
+    virtual Box* createBox() const override;
+
+    //--------------------------------------------------------------------------
+    // Get the name of the specific Box class. Returns "VirtualContainer".
+    virtual std::string getClassName() const override;
+
+    //--------------------------------------------------------------------------
+    // Get the target height of the VirtualContainer.
+    virtual int getHeight() const override;
+
+    //--------------------------------------------------------------------------
+    // Get the target width of the VirtualContainer.
+    virtual int getWidth() const override;
+
+    //--------------------------------------------------------------------------
+    // Set the amount of items in the list. All visible rows are bound again
+    // on the next print.
+    void setItemCount(int count);
+
+    //--------------------------------------------------------------------------
+    // Get the amount of items in the list.
+    int getItemCount() const;
+
+    //--------------------------------------------------------------------------
+    // Set the height of each row in character units. Minimum of 1.
+    void setRowHeight(int height);
+
+    //--------------------------------------------------------------------------
+    // Set the Box that each row Box is copied from. The width of each row Box
+    // is set to the content width of the VirtualContainer and the height is set
+    // to the row height.
+    void setRowTemplate(const Box& rowTemplate);
+
+    //--------------------------------------------------------------------------
+    // Set the binder routine that applies the data of an item to a row Box.
+    // The binder routine receives a reference to the row Box and the index of
+    // the item. The binder is only called when a row Box is assigned a new
+    // item.
+    void setRowBinder(std::function<void(Box&, int)> binder);
+
+    //--------------------------------------------------------------------------
+    // Bind all visible rows again on the next print. Used when the data of the
+    // items changes.
+    void rebindRows();
+
+    //--------------------------------------------------------------------------
+    // Set the index of the first visible item.
+    void setScrollPosition(int item);
+
+    //--------------------------------------------------------------------------
+    // Get the index of the first visible item.
+    int getScrollPosition() const;
+
+protected:
+    int itemCount;
+    int rowHeight;
+    int scrollPos;
+    int rowWidth;
+    int visibleRows;
+
+    Box* rowTemplate;
+    std::function<void(Box&, int)> rowBinder;
+
+    // Pool of recycled row Boxes, indexed by item modulo the pool size, and the
+    // item currently bound to each row Box
+    std::vector<Box*> rowPool;
+    std::vector<int> boundItems;
+
+    // Row Boxes printed during the previous print, in print order
+    std::vector<Box*> printedRows;
+
+    //--------------------------------------------------------------------------
+    // The protocol used to print the Box object to the screen or buffer
+    // (indicated by the drawMode parameter). Each derived class of Box should
+    // implement their own protocol, which is then called through draw(),
+    // buffer(), redraw(), or rebuffer().
+    virtual Reply printProtocol(Position pos, Boundary container,
+            bool drawMode) override;
+
+    //--------------------------------------------------------------------------
+    // Materialize the row pool so that it covers a given amount of visible
+    // rows of a given width. Row Boxes are only created when the pool grows.
+    // Helper method for printProtocol().
+    void fillRowPool(int rows, int width);
+
+    //--------------------------------------------------------------------------
+    // Clear the row pool and free all allocated memory.
+    void clearRowPool();
+
+    //--------------------------------------------------------------------------
+    // Get the maximum scroll position given the amount of visible rows.
+    int getMaxScrollPosition() const;
+
+};
+
+}
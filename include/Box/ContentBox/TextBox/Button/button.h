@@ -54,11 +54,12 @@ public:
             inputEvent::MouseEvent)> action);
 
 protected:
-    // Click handler function that is called in interact()
-    std::function<Reply(Button&)> clickHandler;
-    std::function<Reply(Button&, inputEvent::MouseEvent)> inputClickHandler;
+    // Click handler function that is called in interact(). Actions that do not
+    // take the MouseEvent are wrapped to ignore it
+    std::function<Reply(Button&, inputEvent::MouseEvent)> clickHandler;
 
-    // Indicate if the clickHandler should pass the original InputEvent
+    // Indicate if the clickHandler was set with an action that takes the
+    // MouseEvent
     bool passInput;
 
 };
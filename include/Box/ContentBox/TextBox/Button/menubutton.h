@@ -31,7 +31,10 @@ public:
 
     //--------------------------------------------------------------------------
     // Execute an action given a mouse click. Returns IGNORED if the mouse
-    // event is not a left click. Otherwise returns a user-specified Reply.
+    // event is not a left click. Otherwise enters the entry Menu and returns
+    // the Reply of Menu::enter(). If a Menu is already active, the entry Menu
+    // is pushed onto the MenuManager navigation scheduler and its exit Reply
+    // is executed by the active Menu once it exits.
     virtual Reply interact(inputEvent::MouseEvent action) override;
 
     //--------------------------------------------------------------------------
@@ -4,9 +4,10 @@
 // Author: Franz Alarcon
 //------------------------------------------------------------------------------
 // Description: An EntryTextBox is a type of TextBox that allows the user to
-//     input a text value when the box is interacted. The EntryTextBox stops
-//     reading the user input when the Enter button is clicked or if the user
-//     clicks off the box.
+//     input a text value when the box is interacted. Interacting with the box
+//     gives it the input focus of the active Menu, which then passes keyboard
+//     input to the box. The EntryTextBox stops reading the user input when the
+//     Enter button is clicked or if the user clicks off the box.
 // 
 // Dependencies: TextBox and MenuManager class.
 //------------------------------------------------------------------------------
@@ -37,9 +38,20 @@ public:
     EntryTextBox(const EntryTextBox& copy);
 
     //--------------------------------------------------------------------------
-    // Execute an action given a specific mouse event. Returns an IGNORED Reply.
+    // Execute an action given a specific mouse event. Takes the input focus of
+    // the active Menu and returns a CONTINUE Reply.
     virtual Reply interact(inputEvent::MouseEvent action) override;
 
+    //--------------------------------------------------------------------------
+    // Process a user input while the EntryTextBox holds the input focus.
+    // Returns an IGNORED Reply for mouse inputs outside of the box, which
+    // cancel the entry process; otherwise returns a CONTINUE Reply.
+    virtual Reply focusInput(InputEvent input) override;
+
+    //--------------------------------------------------------------------------
+    // End the user interaction when the input focus is lost.
+    virtual void focusLost() override;
+
     //--------------------------------------------------------------------------
     // Create a deep copy of this TextBox object and return a pointer to that 
     // copy.
@@ -95,8 +107,9 @@ public:
 
     //--------------------------------------------------------------------------
     // Set whether the EntryTextBox will automatically refresh the Menu screen's
-    // contents when the EntryTextBox text changes. This is off by default since
-    // a Menu will default to using auto print.
+    // contents when the EntryTextBox text changes. Refreshes are coalesced
+    // into a single print after the Menu processes all pending input. This is
+    // off by default since a Menu will default to using auto print.
     void autoMenuRefreshing(bool autoRefreshing);
 
 protected:
@@ -120,8 +133,9 @@ protected:
             bool drawMode) override;
         
     //--------------------------------------------------------------------------
-    // Try to refresh the current Menu based on the state of menuRefreshing.
-    // Helper method for interact().
+    // Try to request a refresh of the current Menu based on the state of
+    // menuRefreshing.
+    // Helper method for interact(), focusInput(), and focusLost().
     void tryMenuRefresh() const;
 };
 
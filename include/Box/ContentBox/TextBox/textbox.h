@@ -7,9 +7,10 @@
 //     text that is printed within the dimensions of the TextBox to the console
 //     window. The text content is aligned within the TextBox depending on the
 //     alignment flags specified. Does not produce any output or action upon
-//     interaction.
+//     interaction. The text is shared between copies of a TextBox until one
+//     of the copies changes its text.
 // 
-// Dependencies: ContentBox class.
+// Dependencies: ContentBox class and SharedValue class.
 //------------------------------------------------------------------------------
 
 #pragma once
@@ -17,6 +18,7 @@
 #include <string>
 #include <vector>
 #include "Box/ContentBox/contentbox.h"
+#include "Box/sharedvalue.h"
 
 namespace conu {
 
@@ -53,7 +55,7 @@ public:
     void setText(std::string text);
 
 protected:
-    std::string text;
+    SharedValue<std::string> text;
     std::vector<std::string> lines;
 
     //--------------------------------------------------------------------------
@@ -9,18 +9,26 @@
 //     Graphics are responsible for correctly displaying its canvas given
 //     changes to the dimensions and position of the Graphic at run-time. The
 //     Graphic's Alignment selection will modify how the canvas is displayed
-//     if the visible area is smaller than the size of the canvas.
+//     if the visible area is smaller than the size of the canvas. The canvas
+//     is stored as a single contiguous buffer of rows, and is shared between
+//     copies of a Graphic until one of the copies modifies it. The span of
+//     each row that was modified since the previous print is tracked so that
+//     redrawing the Graphic only prints the modified cells. When buffered as
+//     part of a frame, the Graphic watches its area of the write buffer and
+//     only buffers the modified cells if nothing else was written over it.
 // 
-// Dependencies: ContentBox class.
+// Dependencies: ContentBox class, SharedValue class, and ConsoleEditor class.
 //------------------------------------------------------------------------------
 
 #pragma once
 
 #include <vector>
 #include <string>
+#include <mutex>
 #include <stdexcept>
 #include <algorithm>
 #include "Box/ContentBox/contentbox.h"
+#include "Box/sharedvalue.h"
 
 namespace conu {
 
@@ -29,6 +37,7 @@ class GraphicLine;
 //------------------------------------------------------------------------------
 class Graphic : public ContentBox {
     friend class GraphicLine;
+    friend class GraphicPainter;
 
 public:
     //--------------------------------------------------------------------------
@@ -39,6 +48,19 @@ public:
     // Parameterized constructor
     Graphic(int width, int height);
 
+    //--------------------------------------------------------------------------
+    // Copy constructor. The copy does not share the write buffer watch of the
+    // original Graphic.
+    Graphic(const Graphic& copy);
+
+    //--------------------------------------------------------------------------
+    // Copy assignment operator. Every cell of the canvas is marked as modified.
+    Graphic& operator = (const Graphic& copy);
+
+    //--------------------------------------------------------------------------
+    // Virtual destructor
+    virtual ~Graphic() override;
+
     //--------------------------------------------------------------------------
     // Execute an action given a specific mouse event. Returns an IGNORED Reply.
     virtual Reply interact(inputEvent::MouseEvent action) override;
@@ -60,6 +82,22 @@ public:
     // Set the target width and height of the Graphic
     virtual void setDimensions(int width, int height) override;
 
+    //--------------------------------------------------------------------------
+    // Redraw the Graphic given the same conditions as the previous draw() or
+    // buffer() call. If the placement of the canvas did not change, only the
+    // cells modified since the previous print are drawn.
+    // Requires that the Graphic have been printed through draw() or buffer()
+    // previously. Otherwise, returns FAILED.
+    virtual Reply redraw() override;
+
+    //--------------------------------------------------------------------------
+    // Rebuffer the Graphic given the same conditions as the previous draw() or
+    // buffer() call. If the placement of the canvas did not change, only the
+    // cells modified since the previous print are buffered.
+    // Requires that the Graphic have been printed through draw() or buffer()
+    // previously. Otherwise, returns FAILED.
+    virtual Reply rebuffer() override;
+
     //--------------------------------------------------------------------------
     // Get a GraphicLine from the Graphic's canvas.
     // Does not bounds check
@@ -70,6 +108,12 @@ public:
     // Throws out_of_range exception if index is outisde the canvas range.
     GraphicLine at(int idx);
 
+    //--------------------------------------------------------------------------
+    // Get a character of the Graphic's canvas. Reading a character does not
+    // mark it as modified or duplicate a canvas shared with a copy.
+    // Throws out_of_range exception if the position is outside the canvas.
+    char get(int row, int col) const;
+
     //--------------------------------------------------------------------------
     // Get the entire contents of the Canvas as an std::string object. Each
     // line of the canvas is separated by a newline character.
@@ -79,9 +123,54 @@ public:
     // Clear the Graphic canvas
     void clear();
 
+    //--------------------------------------------------------------------------
+    // Fill every cell of the Graphic canvas with a character.
+    void fill(char fillChar);
+
+    //--------------------------------------------------------------------------
+    // Check if any cell of the canvas was modified since the previous print.
+    bool dirty() const;
+
+    //--------------------------------------------------------------------------
+    // Get the smallest rectangle of canvas cells that contains every cell
+    // modified since the previous print. The rectangle is relative to the
+    // top-left cell of the canvas. If no cell was modified, the returned
+    // Boundary has a right edge less than its left edge.
+    Boundary getDirtyBoundary() const;
+
 private:
     static const char DEFAULT_CANVAS_FILL;
-    std::vector<std::vector<char>> canvas;
+
+    // Canvas structure
+    // Cells of the canvas stored row by row in a single buffer with no
+    // padding, so each row starts width cells after the previous row.
+    struct Canvas {
+        int width;
+        int height;
+        std::vector<char> cells;
+    };
+    SharedValue<Canvas> canvas;
+
+    // Span of columns of a canvas row modified since the previous print. The
+    // row is clean if the first column is greater than the last column
+    struct DirtySpan {
+        int first;
+        int last;
+    };
+    std::vector<DirtySpan> dirtySpans;
+
+    // Guards the dirty spans, since the canvas may be modified while the
+    // Graphic is buffered on another thread
+    mutable std::mutex dirtyLock;
+
+    // Identifier of the write buffer watch over the Graphic, or 0 if the
+    // Graphic was never buffered
+    int bufferWatch;
+
+    // Position of the top-left canvas cell and the visible area of the canvas
+    // during the previous print
+    Position printedOrigin;
+    Boundary printedArea;
 
     //--------------------------------------------------------------------------
     // The protocol used to print the Box object to the screen or buffer
@@ -91,10 +180,60 @@ private:
     virtual Reply printProtocol(Position pos, Boundary container,
             bool drawMode) override;
 
+    //--------------------------------------------------------------------------
+    // Print only the modified cells of the canvas if the canvas is placed the
+    // same as during the previous print.
+    // Returns false if the Graphic must be printed in full instead.
+    // Helper method for redraw() and rebuffer().
+    bool printDirty(bool drawMode);
+
+    //--------------------------------------------------------------------------
+    // Check if printing only the modified cells of the canvas would leave the
+    // Graphic as it would appear if printed in full. Requires the canvas to be
+    // placed the same as during the previous print and, when buffering, that
+    // nothing else was written over the Graphic in the write buffer since.
+    // Helper method for printProtocol() and printDirty().
+    bool canPrintDirty(bool drawMode);
+
+    //--------------------------------------------------------------------------
+    // Print the modified span of each visible canvas row, then mark the
+    // printed cells as unmodified.
+    // Helper method for printProtocol() and printDirty().
+    void printSpans(bool drawMode);
+
+    //--------------------------------------------------------------------------
+    // Watch the area of the Graphic in the write buffer for writes made after
+    // the Graphic was buffered, or stop watching it if the Graphic was drawn
+    // to the screen instead (indicated by the drawMode parameter).
+    // Helper method for printProtocol() and printDirty().
+    void watchBuffer(bool drawMode);
+
+    //--------------------------------------------------------------------------
+    // Get the position of the top-left canvas cell and the visible area of the
+    // canvas given the current position and size of the Graphic.
+    void getPlacement(Position& origin, Boundary& visibleArea);
+
+    //--------------------------------------------------------------------------
+    // Mark a span of columns of a canvas row as modified.
+    void markDirty(int row, int first, int last);
+
+    //--------------------------------------------------------------------------
+    // Mark every cell of the canvas as modified.
+    void markAll();
+
     //--------------------------------------------------------------------------
     // Resize the canvas to fit the Graphic dimensions
     void updateCanvasSize();
 
+    //--------------------------------------------------------------------------
+    // Get a read-only pointer to the first cell of a canvas row.
+    const char* getRow(int row) const;
+
+    //--------------------------------------------------------------------------
+    // Get a modifiable pointer to the first cell of a canvas row. The canvas
+    // is duplicated first if it is shared.
+    char* editRow(int row);
+
     //--------------------------------------------------------------------------
     // Get the horizontal offset of the canvas given that the visible area of
     //     the Graphic is smaller than the canvas size.
@@ -111,8 +250,9 @@ private:
 
 //------------------------------------------------------------------------------
 // GraphicLine class
-// Provides modification access to a specific char array in a Graphic instance's
-//     canvas. 
+// Provides modification access to a single row of a Graphic instance's canvas.
+//     A GraphicLine is a lightweight view of the row and does not own any
+//     cells.
 // Helper class for Graphic
 class GraphicLine {
     friend class Graphic;
@@ -124,25 +264,40 @@ public:
     void operator = (std::string lineText);
 
     //--------------------------------------------------------------------------
-    // Get a reference to a character in the GraphicLine.
-    // Does not bounds check.
+    // Get a reference to a character in the GraphicLine. The character is
+    // marked as modified, since it may be written through the reference.
+    // Does not bounds check. The reference is invalidated if the Graphic is
+    // copied.
     char& operator [] (int idx);
 
     //--------------------------------------------------------------------------
-    // Get a reference to a character in the GraphicLine.
-    // Throws out_of_range exception if index is outisde the line range.
+    // Get a reference to a character in the GraphicLine. The character is
+    // marked as modified, since it may be written through the reference.
+    // Throws out_of_range exception if index is outisde the line range. The
+    // reference is invalidated if the Graphic is copied.
     char& at(int idx);
 
+    //--------------------------------------------------------------------------
+    // Get a character in the GraphicLine. Reading a character does not mark
+    // it as modified or duplicate a canvas shared with a copy.
+    // Throws out_of_range exception if index is outisde the line range.
+    char get(int idx) const;
+
     //--------------------------------------------------------------------------
     // Get a copy of the GraphicLine contents as an std::string object.
     std::string getString() const;
 
+    //--------------------------------------------------------------------------
+    // Get the amount of characters in the GraphicLine.
+    int size() const;
+
 private:
-    std::vector<char>* canvasLine;
+    Graphic* graphic;
+    int row;
 
     //--------------------------------------------------------------------------
     // Private default constructor
-    GraphicLine(std::vector<char>& line);
+    GraphicLine(Graphic& graphic, int row);
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+// graphicpainter.h
+// Interface for the GraphicPainter class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: A GraphicPainter draws shapes onto the canvas of a Graphic.
+//     Lines, rectangles, circles, and ellipses can be drawn as outlines or
+//     filled, enclosed regions can be flood filled, and rectangular areas of
+//     the canvas can be copied or moved. Shapes are clipped to the canvas and
+//     are written as whole row spans wherever possible, so drawing a shape
+//     costs about as much as the amount of rows it covers. A GraphicPainter
+//     is a lightweight view of its Graphic and does not own any cells.
+//
+// Dependencies: Graphic class.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include "Box/ContentBox/graphic.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+class GraphicPainter {
+public:
+    //--------------------------------------------------------------------------
+    // Parameterized constructor. The Graphic must outlive the GraphicPainter.
+    GraphicPainter(Graphic& graphic);
+
+    //--------------------------------------------------------------------------
+    // Draw a straight line between two canvas cells (inclusive).
+    void drawLine(Position from, Position to, char brush);
+
+    //--------------------------------------------------------------------------
+    // Draw the outline of a rectangle of canvas cells. The edges of the
+    // rectangle are inclusive.
+    void drawRect(Boundary rect, char brush);
+
+    //--------------------------------------------------------------------------
+    // Fill a rectangle of canvas cells. The edges of the rectangle are
+    // inclusive.
+    void fillRect(Boundary rect, char brush);
+
+    //--------------------------------------------------------------------------
+    // Draw the outline of the ellipse that fits within a rectangle of canvas
+    // cells. The edges of the rectangle are inclusive.
+    void drawEllipse(Boundary bounds, char brush);
+
+    //--------------------------------------------------------------------------
+    // Fill the ellipse that fits within a rectangle of canvas cells. The edges
+    // of the rectangle are inclusive.
+    void fillEllipse(Boundary bounds, char brush);
+
+    //--------------------------------------------------------------------------
+    // Draw the outline of a circle given its center cell and radius in cells.
+    // Console cells are taller than they are wide, so the circle appears
+    // stretched vertically.
+    void drawCircle(Position center, int radius, char brush);
+
+    //--------------------------------------------------------------------------
+    // Fill a circle given its center cell and radius in cells.
+    void fillCircle(Position center, int radius, char brush);
+
+    //--------------------------------------------------------------------------
+    // Replace the region of horizontally and vertically connected cells that
+    // share the character of a seed cell.
+    // Returns the amount of replaced cells.
+    int floodFill(Position seed, char brush);
+
+    //--------------------------------------------------------------------------
+    // Copy a rectangle of canvas cells so that its top-left cell is placed at
+    // a destination cell. The source and destination may overlap.
+    void copyRect(Boundary source, Position dest);
+
+    //--------------------------------------------------------------------------
+    // Move a rectangle of canvas cells so that its top-left cell is placed at
+    // a destination cell. Source cells that are not covered by the moved
+    // rectangle are filled with a character. The source and destination may
+    // overlap.
+    void moveRect(Boundary source, Position dest, char fillChar);
+
+private:
+    Graphic* graphic;
+
+    //--------------------------------------------------------------------------
+    // Fill a span of columns of a canvas row, clipped to the canvas.
+    void fillSpan(Graphic::Canvas& canvas, int row, int first, int last,
+            char brush);
+
+    //--------------------------------------------------------------------------
+    // Draw or fill the ellipse that fits within a rectangle of canvas cells.
+    // Only the rows of the ellipse within the canvas are visited.
+    // Helper method for the ellipse and circle methods.
+    void traceEllipse(Boundary bounds, char brush, bool filled);
+
+    //--------------------------------------------------------------------------
+    // Get the first and last column of a row of the filled ellipse that fits
+    // within a normalized rectangle. The row must lie within the rectangle.
+    static void ellipseSpan(const Boundary& bounds, int row, int& first,
+            int& last);
+
+    //--------------------------------------------------------------------------
+    // Clip the endpoints of a line to the canvas. Returns false if no part of
+    // the line lies within the canvas.
+    static bool clipLine(const Graphic::Canvas& canvas, Position& from,
+            Position& to);
+
+    //--------------------------------------------------------------------------
+    // Round a clipped coordinate to the nearest cell within a canvas extent.
+    static int clipCoord(double coord, int extent);
+
+    //--------------------------------------------------------------------------
+    // Clip a rectangle to the canvas. Returns false if no cell of the
+    // rectangle lies within the canvas.
+    static bool clipRect(const Graphic::Canvas& canvas, Boundary& rect);
+
+};
+
+}
@@ -13,7 +13,8 @@
 //     aligned within the Box given specified horizontal and vertical alignment
 //     flags.
 // 
-// Dependencies: EditConsole class and Flag enumerators.
+// Dependencies: EditConsole class, BoxArena class, CellSurface class,
+//     DisplayList class, and Flag enumerators.
 //------------------------------------------------------------------------------
 
 #pragma once
@@ -21,7 +22,14 @@
 #include <iostream>
 #include <string>
 #include <limits>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <unordered_map>
 #include "ConsoleEditor/consoleeditor.h"
+#include "ConsoleEditor/cellsurface.h"
+#include "ConsoleEditor/displaylist.h"
+#include "Box/boxarena.h"
 #include "Flag/flag.h"
 
 namespace conu {
@@ -48,8 +56,43 @@ struct BorderFill {
     char bottom;
 };
 
+//------------------------------------------------------------------------------
+// PackedPosition struct
+// A Position stored with 16-bit coordinates. Used to keep the geometry of a
+// Box compact. Coordinates outside the 16-bit range are clamped to it.
+struct PackedPosition {
+    short col;
+    short row;
+
+    PackedPosition(const Position& pos = Position{ 0, 0 });
+    operator Position() const;
+
+    // Clamp a coordinate to the 16-bit range
+    static short toCoord(int value);
+};
+
+//------------------------------------------------------------------------------
+// PackedBoundary struct
+// A Boundary stored with 16-bit coordinates. Used to keep the geometry of a
+// Box compact. Coordinates outside the 16-bit range are clamped to it.
+struct PackedBoundary {
+    short left;
+    short top;
+    short right;
+    short bottom;
+
+    PackedBoundary(const Boundary& bound = Boundary{ 0, 0, 0, 0 });
+    operator Boundary() const;
+};
+
 //------------------------------------------------------------------------------
 class Box {
+    // BoxContainers link contained Boxes to themselves as their parent
+    friend class BoxContainer;
+
+    // The BoxRegistry marks indexed Boxes
+    friend class BoxRegistry;
+
 public:
 
     //--------------------------------------------------------------------------
@@ -60,14 +103,43 @@ public:
     // Parameterized constructor
     Box(int width, int height);
 
+    //--------------------------------------------------------------------------
+    // Copy constructor. The copy is not contained by any BoxContainer.
+    Box(const Box& copy);
+
+    //--------------------------------------------------------------------------
+    // Copy assignment operator. The containing BoxContainer is not changed.
+    Box& operator = (const Box& copy);
+
     //--------------------------------------------------------------------------
     // Virtual destructor
     virtual ~Box();
 
+    //--------------------------------------------------------------------------
+    // Allocate memory for a Box. The Box is allocated from the BoxArena active
+    // on the current thread, or from the free store if no BoxArena is active.
+    static void* operator new(std::size_t size);
+
+    //--------------------------------------------------------------------------
+    // Free the memory of a Box. Memory allocated from a BoxArena is released
+    // back to that arena.
+    static void operator delete(void* ptr);
+
     //--------------------------------------------------------------------------
     // Execute an action given a specific mouse event. 
     virtual Reply interact(inputEvent::MouseEvent action) = 0;
 
+    //--------------------------------------------------------------------------
+    // Execute an action given an input event while the Box holds the input
+    // focus of the active Menu. Returns IGNORED if the input was not handled,
+    // in which case the Menu dispatches the input normally.
+    virtual Reply focusInput(InputEvent input);
+
+    //--------------------------------------------------------------------------
+    // Notify the Box that it no longer holds the input focus of the active
+    // Menu.
+    virtual void focusLost();
+
     //--------------------------------------------------------------------------
     // Create a deep copy of this Box object and return a pointer to that copy.
     virtual Box* copyBox() const = 0;
@@ -88,6 +160,31 @@ public:
     // Get the target width of the Box.
     virtual int getWidth() const = 0;
 
+    //--------------------------------------------------------------------------
+    // Discard the cached measured size of the Box and all BoxContainers that
+    // contain it. Called automatically when a property that affects the size
+    // of the Box changes.
+    void invalidateLayout();
+
+    //--------------------------------------------------------------------------
+    // Set whether the Box retains a surface of the cells it printed. While the
+    // retained surface is valid, printing the Box with the same position and
+    // container prints the surface instead of running the print protocol.
+    // The surface stays allocated after retention is disabled so that it can
+    // be changed while the Box is printed. Disabled by default.
+    void retainSurface(bool retain);
+
+    //--------------------------------------------------------------------------
+    // Check if the Box retains a surface of the cells it printed.
+    bool retainsSurface() const;
+
+    //--------------------------------------------------------------------------
+    // Discard the retained surface of the Box and all BoxContainers that
+    // contain it, so that they are printed through their print protocol again.
+    // Called automatically when a property that affects the printed content of
+    // the Box changes.
+    void invalidateSurface();
+
     //--------------------------------------------------------------------------
     // Get the actual position of the Box when printed. 
     // If the Box was not printed before, returns Position { -1, -1 }.
@@ -119,6 +216,12 @@ public:
     // previously. Otherwise, returns FAILED.
     virtual Reply rebuffer();
 
+    //--------------------------------------------------------------------------
+    // Buffer the Box like buffer() while recording every cell it writes into
+    // a DisplayList. The DisplayList is cleared first. Replaying the list
+    // reproduces the print without walking the Box again.
+    Reply record(DisplayList& list, Position pos, Boundary container);
+
     //--------------------------------------------------------------------------
     // Set the target width and height of the Box.
     virtual void setDimensions(int width, int height);
@@ -188,6 +291,11 @@ public:
     // Box object. Returns false if the Box has not been drawn yet.
     virtual bool posInBounds(Position pos) const;
 
+    //--------------------------------------------------------------------------
+    // Get the unique identifier of the Box. Every Box is given a new
+    // identifier on construction, including copies.
+    unsigned getId() const;
+
 protected:
     //--------------------------------------------------------------------------
     // Box data members
@@ -195,26 +303,41 @@ protected:
     // Static console object
     static ConsoleEditor& console;
 
-    // Box dimensions and position information
-    Position absolutePos;
+    // Box dimensions and position information. Target dimensions can be
+    // MAXIMUM, so they stay int; actual dimensions and positions never exceed
+    // the console window and are stored as 16-bit values.
+    PackedPosition absolutePos;
     int targetHeight;
     int targetWidth;
-    int actualHeight;
-    int actualWidth;
+    short actualHeight;
+    short actualWidth;
 
-    // Box border information
-    int horizBorderSize;
-    int vertBorderSize;
-    BorderFill borderFill;
+    // Box border information. The border fill is kept out of line.
+    short horizBorderSize;
+    short vertBorderSize;
 
     // Redraw method utilization
-    Position targetPos;
-    Boundary savedBound;
+    PackedPosition targetPos;
+    PackedBoundary savedBound;
 
     // Drawing information
     Align alignment;
-    bool drawn;
-    bool transparent;
+    bool drawn : 1;
+    bool transparent : 1;
+
+    // Indicates if the Box is indexed by the BoxRegistry. Packed with the
+    // drawing flags
+    bool indexed : 1;
+
+    // Indicates if the Box retains a surface of its printed cells
+    bool retained : 1;
+
+    // Indicates that the print protocol paints every cell of the Box while it
+    // is not transparent. BoxContainers only treat such Boxes as covering the
+    // Boxes and base cells behind them. Set by the Box classes known to do
+    // so; classes derived from them that override printProtocol() without
+    // painting their whole base must clear it.
+    bool opaqueBase : 1;
 
     //--------------------------------------------------------------------------
     // The protocol used to print the Box object to the screen or buffer
@@ -224,18 +347,63 @@ protected:
     virtual Reply printProtocol(Position pos, Boundary container, 
             bool drawMode) = 0;
 
+    //--------------------------------------------------------------------------
+    // Discard the cached measured size of the Box, if any. Returns true if the
+    // Box had a cached measured size.
+    // Helper method for invalidateLayout().
+    virtual bool discardMeasure();
+
     //--------------------------------------------------------------------------
     // Print a line of text to the console's screen or buffer (indicated by
     // the drawMode parameter).
     // Helper function for printProtocol.
     void printLine(const Position& pos, const char text[], bool drawMode);
 
+    //--------------------------------------------------------------------------
+    // Print a given amount of characters of text to the console's screen or
+    // buffer (indicated by the drawMode parameter). The text does not need to
+    // be null-terminated.
+    // Helper function for printProtocol.
+    void printLine(const Position& pos, const char text[], int length,
+            bool drawMode);
+
+    //--------------------------------------------------------------------------
+    // Print only the first and last edgeLength characters of a span of text to
+    // the console's screen or buffer (indicated by the drawMode parameter),
+    // leaving the characters between them unchanged.
+    // Helper function for printBase.
+    void printEdges(const Position& pos, const char text[], int length,
+            int edgeLength, bool drawMode);
+
     //--------------------------------------------------------------------------
     // Calculate the actual dimentions and position of the Box. Returns the
     // calculated absolute origin position of the ContentBox (relative to the
     // origin of the console screen).
     virtual void calculateActualDimAndPos(Position pos, Boundary container);
 
+    //--------------------------------------------------------------------------
+    // Clip a container Boundary to the console window.
+    static Boundary clipToWindow(Boundary container);
+
+    //--------------------------------------------------------------------------
+    // Record a print of the Box that was skipped because the Box does not fit
+    // within the container boundary. The Box is given empty actual dimensions
+    // so that it cannot be interacted with.
+    void skipPrint(Position pos, Boundary container);
+
+    //--------------------------------------------------------------------------
+    // Clamp a dimension or border size to the range stored by a Box.
+    static short toStoredSize(int size);
+
+    //--------------------------------------------------------------------------
+    // Fit a rectangle of a given width and height at a given position within a
+    // container boundary using the same rules as calculateActualDimAndPos().
+    // The fitted origin position and dimensions are written to fitPos,
+    // fitWidth, and fitHeight.
+    static void fitToContainer(Position pos, const Boundary& container,
+            int width, int height, Position& fitPos, int& fitWidth,
+            int& fitHeight);
+
     //--------------------------------------------------------------------------
     // Print the base of the Box, including the Box borders and clearing the 
     // inside of the Box.
@@ -244,6 +412,14 @@ protected:
     // parameter.
     virtual void printBase(Position pos, Boundary container, bool drawMode);
 
+    //--------------------------------------------------------------------------
+    // Paint the base of the Box using its current actual dimensions and
+    // position. Interior cells flagged in coveredCells (indexed row by row
+    // from the top-left cell of the Box) are covered by opaque content, so
+    // they are not painted. A nullptr coveredCells paints every cell.
+    // Helper method for printBase().
+    void paintBase(bool drawMode, const std::vector<char>* coveredCells);
+
 private:
     //--------------------------------------------------------------------------
     // Static const members
@@ -255,6 +431,88 @@ private:
     static const int DEFAULT_VERT_BORDER_SIZE;
     static const BorderFill DEFAULT_BORDER_FILL;
 
+    // Maximum amount of base rows cached on each thread
+    static const unsigned MAX_CACHED_BASE_ROWS;
+
+    // BaseRows structure
+    // Pre-built rows of a Box base for a single combination of width, vertical
+    // border size, and border fill.
+    struct BaseRows {
+        std::string top;
+        std::string bottom;
+        std::string internal;
+    };
+
+    // RetainedSurface structure
+    // The cells printed by a Box and whether they match the current content of
+    // the Box. The flag is atomic since content can be invalidated by input
+    // handling while the Box is printed.
+    struct RetainedSurface {
+        CellSurface cells;
+        std::atomic<bool> valid;
+    };
+
+    // ColdState structure
+    // Data of a Box that is rarely set and is not read while laying out Boxes.
+    // Only allocated for Boxes with a border fill other than the default or a
+    // retained surface, and kept until the Box is destroyed.
+    struct ColdState {
+        BorderFill borderFill;
+        std::unique_ptr<RetainedSurface> surface;
+    };
+
+    // Base rows of the current thread, keyed by width, vertical border size,
+    // and border fill. Shared by every Box printed on the thread
+    static thread_local std::unordered_map<unsigned long long, BaseRows>
+            baseRowCache;
+
+    // Identifier of the next constructed Box
+    static std::atomic<unsigned> nextId;
+
+    // Unique identifier of the Box
+    unsigned boxId;
+
+    // Containing BoxContainer, or nullptr if the Box is not contained
+    Box* parent;
+
+    // Out of line data of the Box, or nullptr if every field is the default
+    std::unique_ptr<ColdState> cold;
+
+    //--------------------------------------------------------------------------
+    // Get the base rows for the current actual width, vertical border size,
+    // and border fill of the Box, building them if they are not cached.
+    // Helper method for printBase().
+    const BaseRows& getBaseRows() const;
+
+    //--------------------------------------------------------------------------
+    // Get the out of line data of the Box, allocating it if needed. The data
+    // is never replaced once allocated, so that it is not freed while the Box
+    // is printed on another thread.
+    ColdState& getColdState();
+
+    //--------------------------------------------------------------------------
+    // Get the retained surface of the Box, or nullptr if none is allocated.
+    RetainedSurface* getSurface() const;
+
+    //--------------------------------------------------------------------------
+    // Call the print protocol of the Box. While overdraw tracking is enabled,
+    // the cells written by the protocol are recorded under the class name of
+    // the Box.
+    // Helper method for draw(), buffer(), redraw(), and rebuffer().
+    Reply runPrintProtocol(Position pos, Boundary container, bool drawMode);
+
+    //--------------------------------------------------------------------------
+    // Print the retained surface of the Box if it is valid for the given
+    // position and container. Otherwise, run the print protocol and retain
+    // the printed cells.
+    // Helper method for runPrintProtocol().
+    Reply printRetained(Position pos, Boundary container, bool drawMode);
+
+    //--------------------------------------------------------------------------
+    // Check if two Boundary structs hold the same rectangle.
+    // Helper method for printRetained().
+    static bool sameBoundary(const Boundary& first, const Boundary& second);
+
 };
 
 //------------------------------------------------------------------------------
@@ -265,4 +523,56 @@ inline void Box::printLine(const Position& pos, const char text[],
             : console.writeToBuffer(pos, text);
 }
 
+//------------------------------------------------------------------------------
+// Inline printLine() definition with text length.
+inline void Box::printLine(const Position& pos, const char text[], int length,
+        bool useDrawing) {
+    useDrawing ? console.writeToScreen(pos, text, length)
+            : console.writeToBuffer(pos, text, length);
+}
+
+//------------------------------------------------------------------------------
+// Inline printEdges() definition.
+inline void Box::printEdges(const Position& pos, const char text[], int length,
+        int edgeLength, bool useDrawing) {
+    useDrawing ? console.writeEdgesToScreen(pos, text, length, edgeLength)
+            : console.writeEdgesToBuffer(pos, text, length, edgeLength);
+}
+
+//------------------------------------------------------------------------------
+// Inline PackedPosition definitions.
+inline PackedPosition::PackedPosition(const Position& pos) :
+    col{ toCoord(pos.col) },
+    row{ toCoord(pos.row) } {
+
+}
+
+inline PackedPosition::operator Position() const {
+    return Position{ col, row };
+}
+
+inline short PackedPosition::toCoord(int value) {
+    if (value > (std::numeric_limits<short>::max)()) {
+        return (std::numeric_limits<short>::max)();
+    }
+    if (value < (std::numeric_limits<short>::min)()) {
+        return (std::numeric_limits<short>::min)();
+    }
+    return static_cast<short>(value);
+}
+
+//------------------------------------------------------------------------------
+// Inline PackedBoundary definitions.
+inline PackedBoundary::PackedBoundary(const Boundary& bound) :
+    left{ PackedPosition::toCoord(bound.left) },
+    top{ PackedPosition::toCoord(bound.top) },
+    right{ PackedPosition::toCoord(bound.right) },
+    bottom{ PackedPosition::toCoord(bound.bottom) } {
+
+}
+
+inline PackedBoundary::operator Boundary() const {
+    return Boundary{ left, top, right, bottom };
+}
+
 }
@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+// boxarena.h
+// Interface for the BoxArena class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: A BoxArena is a region allocator for trees of Box objects. 
+//     Boxes allocated while a BoxArena is active on the current thread are
+//     placed contiguously within large memory blocks owned by the arena.
+//     Deleting an arena-allocated Box runs its destructor but does not free
+//     its memory; all blocks are released at once when the BoxArena is
+//     destroyed, and are reused once every allocated Box has been deleted.
+//     Boxes allocated from a BoxArena must not outlive it.
+//
+// Dependencies: None.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+class BoxArena {
+public:
+    // Default size of each memory block in bytes
+    static const std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    //--------------------------------------------------------------------------
+    // Scope class
+    // Makes a BoxArena the active arena of the current thread for the lifetime
+    //     of the Scope object, restoring the previously active arena on
+    //     destruction. A nullptr arena makes allocations use the free store.
+    class Scope {
+    public:
+        //----------------------------------------------------------------------
+        // Constructor
+        Scope(BoxArena* arena);
+
+        //----------------------------------------------------------------------
+        // Destructor
+        ~Scope();
+
+        Scope(const Scope& copy) = delete;
+        Scope& operator = (const Scope& copy) = delete;
+
+    private:
+        BoxArena* prevArena;
+
+    };
+
+    //--------------------------------------------------------------------------
+    // Parameterized constructor
+    BoxArena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+    //--------------------------------------------------------------------------
+    // Copy constructor (deleted)
+    BoxArena(const BoxArena& copy) = delete;
+
+    //--------------------------------------------------------------------------
+    // Copy assignment operator (deleted)
+    BoxArena& operator = (const BoxArena& copy) = delete;
+
+    //--------------------------------------------------------------------------
+    // Destructor. Releases all memory blocks at once.
+    ~BoxArena();
+
+    //--------------------------------------------------------------------------
+    // Allocate a region of memory aligned for any fundamental type. If every
+    // previous allocation has been released, the memory blocks are reused
+    // from the start.
+    void* allocate(std::size_t size);
+
+    //--------------------------------------------------------------------------
+    // Mark a previous allocation as released. The memory is not reclaimed
+    // until every allocation of the BoxArena has been released. May be called
+    // from any thread.
+    void release();
+
+    //--------------------------------------------------------------------------
+    // Get the amount of allocations that have not been released.
+    int getLiveCount() const;
+
+    //--------------------------------------------------------------------------
+    // Get the total amount of bytes reserved by the memory blocks.
+    std::size_t getReservedSize() const;
+
+    //--------------------------------------------------------------------------
+    // Get the BoxArena that is active on the current thread. Returns nullptr
+    // if no BoxArena is active.
+    static BoxArena* getActive();
+
+    //--------------------------------------------------------------------------
+    // Get the BoxArena whose memory blocks contain a given address. Returns
+    // nullptr if the address was not allocated from any BoxArena. Only takes
+    // a lock while at least one BoxArena exists.
+    static BoxArena* findOwner(const void* ptr);
+
+private:
+    // Block structure
+    // Helper structure for a single memory block of the arena
+    struct Block {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks;
+    std::size_t blockSize;
+    std::size_t currBlock;
+    std::size_t offset;
+    std::atomic<int> liveCount;
+
+    // Arena that Boxes are allocated from on the current thread
+    static thread_local BoxArena* activeArena;
+
+    // Owner structure
+    // Helper structure for the end address and owning arena of a block
+    struct Owner {
+        const char* end;
+        BoxArena* arena;
+    };
+
+    // Blocks of every existing arena, keyed by their start address
+    static std::map<const char*, Owner> blockOwners;
+    static std::mutex ownersLock;
+    static std::atomic<int> arenaCount;
+
+};
+
+}
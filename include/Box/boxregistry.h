@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+// boxregistry.h
+// Interface for the BoxRegistry and BoxHandle classes
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: The BoxRegistry keeps an index of live Box objects by their
+//     unique identifier. A BoxHandle is a typed reference to a Box that is
+//     checked against the BoxRegistry on every access, so a handle to a Box
+//     that has been removed, replaced, or destroyed safely resolves to
+//     nullptr instead of dangling. Only Boxes that a BoxHandle has been made
+//     for are indexed. Access to the BoxRegistry is thread safe.
+//     The BoxRegistry class is a singleton and can be accessed through the
+//     BoxRegistry::getInstance() method.
+// 
+// Dependencies: Box class.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <unordered_map>
+#include <mutex>
+#include "Box/box.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+class BoxRegistry {
+    // Boxes remove themselves from the index on destruction
+    friend class Box;
+
+public:
+    //--------------------------------------------------------------------------
+    // Get the singleton instance of the BoxRegistry class.
+    static BoxRegistry& getInstance();
+
+    //--------------------------------------------------------------------------
+    // Add a Box to the index of live Boxes. The Box is removed from the index
+    // when it is destroyed.
+    void index(Box& box);
+
+    //--------------------------------------------------------------------------
+    // Find an indexed Box given its identifier. Returns nullptr if the Box was
+    // destroyed or was never indexed.
+    Box* find(unsigned id) const;
+
+private:
+    mutable std::mutex indexLock;
+    std::unordered_map<unsigned, Box*> liveBoxes;
+
+    //--------------------------------------------------------------------------
+    // Private constructor
+    BoxRegistry();
+
+    //--------------------------------------------------------------------------
+    // Copy constructor (deleted)
+    BoxRegistry(const BoxRegistry& copy) = delete;
+
+    //--------------------------------------------------------------------------
+    // Copy assignment operator (deleted)
+    BoxRegistry& operator = (const BoxRegistry& copy) = delete;
+
+    //--------------------------------------------------------------------------
+    // Remove a Box from the index given its identifier.
+    void unindex(unsigned id);
+
+};
+
+//------------------------------------------------------------------------------
+// BoxHandle class
+// Typed reference to a Box that resolves to nullptr once the Box is destroyed.
+//     Resolving a BoxHandle is a constant time lookup and does not require a
+//     dynamic_cast.
+template <typename T>
+class BoxHandle {
+public:
+    //--------------------------------------------------------------------------
+    // Default constructor. The handle does not refer to any Box.
+    BoxHandle() :
+        boxId{ 0 },
+        box{ nullptr } {
+
+    }
+
+    //--------------------------------------------------------------------------
+    // Parameterized constructor. Indexes the Box in the BoxRegistry.
+    BoxHandle(T& inBox) :
+        boxId{ inBox.getId() },
+        box{ &inBox } {
+
+        BoxRegistry::getInstance().index(inBox);
+    }
+
+    //--------------------------------------------------------------------------
+    // Get a pointer to the referred Box. Returns nullptr if the Box has been
+    // destroyed or if the handle does not refer to any Box.
+    T* get() const {
+        if (box == nullptr
+                || BoxRegistry::getInstance().find(boxId) == nullptr) {
+            return nullptr;
+        }
+        return box;
+    }
+
+    //--------------------------------------------------------------------------
+    // Access the referred Box. The Box must still exist.
+    T* operator -> () const {
+        return get();
+    }
+
+    //--------------------------------------------------------------------------
+    // Access the referred Box. The Box must still exist.
+    T& operator * () const {
+        return *get();
+    }
+
+    //--------------------------------------------------------------------------
+    // Check if the referred Box still exists.
+    explicit operator bool () const {
+        return get() != nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    // Get the identifier of the referred Box. Returns 0 if the handle does not
+    // refer to any Box.
+    unsigned getId() const {
+        return boxId;
+    }
+
+private:
+    unsigned boxId;
+    T* box;
+
+};
+
+}
@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+// sharedvalue.h
+// Interface for the SharedValue class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: A SharedValue is a copy-on-write wrapper for the content data
+//     of a Box. Copies of a SharedValue share the same immutable value until
+//     one of the copies requests to edit it, at which point that copy receives
+//     its own duplicate of the value. Copying a Box with shared content data
+//     therefore does not duplicate that data until the copy is changed.
+//     References obtained through edit() are only valid until the SharedValue
+//     is next copied.
+//
+// Dependencies: None.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+template <typename T>
+class SharedValue {
+public:
+    //--------------------------------------------------------------------------
+    // Default constructor
+    SharedValue() :
+        value{ std::make_shared<T>() } {
+
+    }
+
+    //--------------------------------------------------------------------------
+    // Parameterized constructor
+    SharedValue(T inValue) :
+        value{ std::make_shared<T>(std::move(inValue)) } {
+
+    }
+
+    //--------------------------------------------------------------------------
+    // Value assignment operator. Reuses the held value if it is not shared.
+    SharedValue& operator = (T inValue) {
+        if (value.use_count() == 1) {
+            *value = std::move(inValue);
+        }
+        else {
+            value = std::make_shared<T>(std::move(inValue));
+        }
+        return *this;
+    }
+
+    //--------------------------------------------------------------------------
+    // Get a read-only reference to the held value.
+    const T& get() const {
+        return *value;
+    }
+
+    //--------------------------------------------------------------------------
+    // Get a modifiable reference to the held value. The value is duplicated
+    // first if it is shared with any other SharedValue.
+    T& edit() {
+        if (value.use_count() != 1) {
+            value = std::make_shared<T>(*value);
+        }
+        return *value;
+    }
+
+    //--------------------------------------------------------------------------
+    // Check if the held value is shared with any other SharedValue.
+    bool isShared() const {
+        return value.use_count() > 1;
+    }
+
+private:
+    std::shared_ptr<T> value;
+
+};
+
+}
@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+// cellsurface.h
+// Interface for the CellSurface class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: A CellSurface is a rectangular grid of console cells that
+//     retains the characters written within its boundary. Only cells that
+//     were written to are part of the surface, so a surface that is printed
+//     again leaves every other cell untouched. Cells are recorded through
+//     ConsoleEditor::beginCapture() and printed back as horizontal spans of
+//     written cells.
+//
+// Dependencies: InputEvent struct.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include "ConsoleEditor/inputevent.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+class CellSurface {
+public:
+    //--------------------------------------------------------------------------
+    // Default constructor
+    CellSurface();
+
+    //--------------------------------------------------------------------------
+    // Clear the surface and set the clipping boundary that recorded cells are
+    // confined to.
+    void reset(const Boundary& clip);
+
+    //--------------------------------------------------------------------------
+    // Record a given amount of characters of text written starting at some
+    // position. Characters outside of the clipping boundary are ignored.
+    void record(const Position& pos, const char text[], int length);
+
+    //--------------------------------------------------------------------------
+    // Shrink the surface to the smallest rectangle that holds every recorded
+    // cell. The clipping boundary is kept.
+    void trim();
+
+    //--------------------------------------------------------------------------
+    // Get the clipping boundary set by the previous reset().
+    const Boundary& getClip() const;
+
+    //--------------------------------------------------------------------------
+    // Call a print routine for each horizontal span of recorded cells, row by
+    // row. The routine receives the position of the span, its characters, and
+    // its length.
+    void forEachSpan(const std::function<void(const Position&, const char[],
+            int)>& print) const;
+
+private:
+    Boundary clip;
+
+    // Top left cell and dimensions of the recorded area
+    Position origin;
+    int width;
+    int height;
+
+    // Characters of the recorded area and whether each cell was written to,
+    // stored row by row
+    std::vector<char> cells;
+    std::vector<char> written;
+
+};
+
+}
@@ -10,7 +10,8 @@
 //      ConsoleEditor::getInstance() method. 
 // 
 // Supported OS: Windows
-// Dependencies: InputEvent struct
+// Dependencies: InputEvent struct, OverdrawMap class, CellSurface class, and
+//      DisplayList class
 //------------------------------------------------------------------------------
 
 #pragma once
@@ -21,9 +22,15 @@
 #include <vector>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <functional>
 #include <algorithm>
+#include <atomic>
+#include <string>
 #include "ConsoleEditor/inputevent.h"
+#include "ConsoleEditor/overdrawmap.h"
+#include "ConsoleEditor/cellsurface.h"
+#include "ConsoleEditor/displaylist.h"
 
 namespace conu {
 
@@ -64,6 +71,21 @@ public:
     // Check if the resize manager is currently running.
     bool resizeManagerRunning() const;
 
+    //--------------------------------------------------------------------------
+    // Launch the present thread if it is not already started. While the
+    // present thread is running, presentWriteBuffer() hands frames off to it
+    // instead of printing them on the calling thread.
+    void startPresenter();
+
+    //--------------------------------------------------------------------------
+    // Terminate the present thread if it is currently running. Any frame that
+    // was already handed off is printed before the thread exits.
+    void stopPresenter();
+
+    //--------------------------------------------------------------------------
+    // Check if the present thread is currently running.
+    bool presenterRunning() const;
+
     //--------------------------------------------------------------------------
     // Set the height and width of the active console window in chracter units. 
     bool setWindowDimensions(short width, short height);
@@ -100,6 +122,16 @@ public:
     // Get any input from in the console input buffer, inluding mouse movements.
     InputEvent getRawInput();
 
+    //--------------------------------------------------------------------------
+    // Check if there are unread inputs in the console input buffer.
+    bool inputPending() const;
+
+    //--------------------------------------------------------------------------
+    // Check if there are unread mouse or keyboard inputs in the console input
+    // buffer that getButtonInput() would return. Mouse movements at the front
+    // of the input buffer are discarded.
+    bool buttonInputPending();
+
     //--------------------------------------------------------------------------
     // Get the current X and Y position of the mouse cursor.
     Position getMousePosition();
@@ -133,18 +165,176 @@ public:
     // position.
     void writeToScreen(const Position& pos, const char text[]);
 
+    //--------------------------------------------------------------------------
+    // Write a given amount of characters of text to the console screen starting
+    // at some given position. The text does not need to be null-terminated.
+    void writeToScreen(const Position& pos, const char text[], int length);
+
     //--------------------------------------------------------------------------
     // Add character text to the write buffer starting at some given position.
     void writeToBuffer(const Position& pos, const char text[]);
 
     //--------------------------------------------------------------------------
-    // Print the contents of the write buffer to the console window.
+    // Add a given amount of characters of text to the write buffer starting at
+    // some given position. The text does not need to be null-terminated.
+    void writeToBuffer(const Position& pos, const char text[], int length);
+
+    //--------------------------------------------------------------------------
+    // Write only the edges of a span of text to the console screen starting at
+    // some given position. The first and last edgeLength characters of the
+    // span are written; the characters between them are left unchanged on the
+    // screen.
+    void writeEdgesToScreen(const Position& pos, const char text[], int length,
+            int edgeLength);
+
+    //--------------------------------------------------------------------------
+    // Add only the edges of a span of text to the write buffer starting at some
+    // given position. The first and last edgeLength characters of the span are
+    // written; the characters between them are left unchanged in the buffer.
+    void writeEdgesToBuffer(const Position& pos, const char text[], int length,
+            int edgeLength);
+
+    //--------------------------------------------------------------------------
+    // Watch a rectangle of write buffer cells for changes. Any later write to
+    // the write buffer within the rectangle marks the watch as disturbed. Pass
+    // 0 as the watch identifier to start a new watch, or the identifier of an
+    // existing watch to move it to a new rectangle and clear its disturbed
+    // mark.
+    // Returns the identifier of the watch.
+    int watchBufferRegion(int watchId, const Boundary& rect);
+
+    //--------------------------------------------------------------------------
+    // Check if the write buffer was written to within the rectangle of a watch
+    // since the watch was last set. Returns true for an unknown watch.
+    bool bufferRegionDisturbed(int watchId) const;
+
+    //--------------------------------------------------------------------------
+    // Stop watching a rectangle of write buffer cells given the identifier
+    // returned by watchBufferRegion().
+    void unwatchBufferRegion(int watchId);
+
+    //--------------------------------------------------------------------------
+    // Get the amount of cells written to the console screen or write buffer
+    // since the previous call, and reset the count.
+    unsigned long long takeCellWriteCount();
+
+    //--------------------------------------------------------------------------
+    // Set whether or not the cells written to the console screen or write
+    // buffer are recorded in the overdraw map. Enabling tracking resets the
+    // overdraw map.
+    void setOverdrawTracking(bool tracking);
+
+    //--------------------------------------------------------------------------
+    // Check if overdraw tracking is enabled.
+    bool overdrawTracking() const;
+
+    //--------------------------------------------------------------------------
+    // Clear the overdraw map and resize it to the write buffer.
+    void resetOverdraw();
+
+    //--------------------------------------------------------------------------
+    // Set the name of the writer that is recorded in the overdraw map for the
+    // cells written by the calling thread.
+    // Returns the identifier of the previous writer of the calling thread, to
+    // be passed to restoreCellWriter().
+    int setCellWriter(const std::string& name);
+
+    //--------------------------------------------------------------------------
+    // Restore the writer of the calling thread given the identifier returned
+    // by setCellWriter().
+    void restoreCellWriter(int writer);
+
+    //--------------------------------------------------------------------------
+    // Get a copy of the overdraw map recorded since the previous reset.
+    OverdrawMap getOverdraw() const;
+
+    //--------------------------------------------------------------------------
+    // Print the overdraw map as a heatmap over the console screen or write
+    // buffer (indicated by the drawMode parameter). The heatmap is not
+    // recorded in the overdraw map or the cell write count.
+    void printOverdraw(bool drawMode);
+
+    //--------------------------------------------------------------------------
+    // Record every cell the calling thread writes to the console screen or
+    // write buffer into a CellSurface until the matching endCapture() call.
+    // Captures can be nested; each write is recorded into every open capture
+    // of the calling thread.
+    void beginCapture(CellSurface& surface);
+
+    //--------------------------------------------------------------------------
+    // Stop recording into the most recent capture opened by the calling
+    // thread through beginCapture().
+    void endCapture();
+
+    //--------------------------------------------------------------------------
+    // Record every cell the calling thread writes to the console screen or
+    // write buffer into a DisplayList until the matching endRecording() call.
+    // Recordings can be nested like captures.
+    void beginRecording(DisplayList& list);
+
+    //--------------------------------------------------------------------------
+    // Stop recording into the most recent DisplayList opened by the calling
+    // thread through beginRecording().
+    void endRecording();
+
+    //--------------------------------------------------------------------------
+    // Check if the calling thread has an open capture or recording.
+    bool capturing() const;
+
+    //--------------------------------------------------------------------------
+    // Lock the write buffer for the calling thread so that a whole frame can be
+    // buffered without locking on every write. Other threads block on any
+    // access to the write buffer until unlockWriteBuffer() is called.
+    void lockWriteBuffer();
+
+    //--------------------------------------------------------------------------
+    // Release the write buffer lock acquired through lockWriteBuffer().
+    void unlockWriteBuffer();
+
+    //--------------------------------------------------------------------------
+    // Allow the calling thread to write to the write buffer on behalf of the
+    // thread that currently holds it through lockWriteBuffer(). The caller is
+    // responsible for only writing to regions that no other thread is writing
+    // to at the same time.
+    void borrowWriteBuffer();
+
+    //--------------------------------------------------------------------------
+    // Stop writing on behalf of the thread that holds the write buffer.
+    void returnWriteBuffer();
+
+    //--------------------------------------------------------------------------
+    // Check if the calling thread holds or has borrowed the write buffer.
+    bool ownsWriteBuffer() const;
+
+    //--------------------------------------------------------------------------
+    // Print the contents of the write buffer to the console window. Only the
+    // span of each row that differs from the frame shown on the console window
+    // is written.
     void printWriteBuffer();
 
+    //--------------------------------------------------------------------------
+    // Hand a snapshot of the write buffer off to the present thread, which
+    // prints it to the console window while the caller builds the next frame.
+    // Only one frame can wait for the present thread at a time; blocks until
+    // the previously handed off frame has been picked up.
+    // Prints the write buffer directly if the present thread is not running.
+    void presentWriteBuffer();
+
+    //--------------------------------------------------------------------------
+    // Block until every frame handed off to the present thread has been
+    // printed to the console window.
+    void waitForPresenter();
+
     //--------------------------------------------------------------------------
     // Clear the console screen.
     void clearScreen();
 
+    //--------------------------------------------------------------------------
+    // Discard the record of the frame shown on the console window so that the
+    // next printed frame is written in full. Used after writing to the console
+    // window without the ConsoleEditor.
+    void invalidateShownFrame();
+
     //--------------------------------------------------------------------------
     // Clear the write buffer with space characters.
     void clearWriteBuffer();
@@ -184,6 +374,50 @@ private:
     // Write buffer information
     std::vector<std::vector<char>> writeBuffer;
     std::mutex writeBufferLock;
+    static thread_local bool writeBufferOwner;
+
+    // Present thread instance members
+    std::thread presenterThread;
+    std::vector<std::vector<char>> pendingFrame;
+    std::vector<std::vector<char>> presentFrame;
+    bool terminatePresenter, presenterActive;
+    bool framePending, framePresenting;
+    std::mutex presentLock;
+    std::mutex presenterControlLock;
+    std::condition_variable presentCV;
+
+    // Cells last written to the console window, used to print only the spans
+    // of a frame that changed
+    std::vector<std::vector<char>> shownFrame;
+    std::mutex shownFrameLock;
+
+    // RegionWatch structure
+    // A rectangle of write buffer cells and whether it was written to since
+    // the watch was set
+    struct RegionWatch {
+        int id;
+        Boundary rect;
+        bool disturbed;
+    };
+
+    // Watched rectangles of the write buffer
+    std::vector<RegionWatch> regionWatches;
+    std::atomic<int> watchCount;
+    int nextWatchId;
+    mutable std::mutex watchLock;
+
+    // Amount of cells written since the previous takeCellWriteCount()
+    std::atomic<unsigned long long> cellWriteCount;
+
+    // Overdraw tracking information
+    std::atomic<bool> trackingOverdraw;
+    OverdrawMap overdrawMap;
+    mutable std::mutex overdrawLock;
+    static thread_local int cellWriter;
+
+    // Open captures and recordings of the current thread, innermost last
+    static thread_local std::vector<CellSurface*> captures;
+    static thread_local std::vector<DisplayList*> recordings;
 
     //--------------------------------------------------------------------------
     // Private default constructor for ConsoleEditor class.
@@ -201,6 +435,34 @@ private:
     // Thread for polling and handling window resizing events.
     void resizeManager();
 
+    //--------------------------------------------------------------------------
+    // Thread for printing frames handed off through presentWriteBuffer().
+    void presenter();
+
+    //--------------------------------------------------------------------------
+    // Account for a given amount of characters of text written starting at
+    // some position: count the written cells, record them in the overdraw map
+    // if overdraw tracking is enabled, and record them in the open captures
+    // and recordings of the calling thread.
+    void recordWrite(const Position& pos, const char text[], int length);
+
+    //--------------------------------------------------------------------------
+    // Mark every watch that overlaps a rectangle of the write buffer as
+    // disturbed.
+    void disturbWatches(const Boundary& rect);
+
+    //--------------------------------------------------------------------------
+    // Record a given amount of characters of text written directly to the
+    // console window starting at some position in the shown frame.
+    void recordShown(const Position& pos, const char text[], int length);
+
+    //--------------------------------------------------------------------------
+    // Print a frame of characters to the console window row by row. Only the
+    // span between the first and last cell of each row that differ from the
+    // shown frame is written.
+    // Helper method for printWriteBuffer() and presenter().
+    void writeFrame(const std::vector<std::vector<char>>& frame);
+
 };
 
 }
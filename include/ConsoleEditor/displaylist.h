@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+// displaylist.h
+// Interface for the DisplayList class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: A DisplayList is a flat list of draw commands that reproduces
+//     the cells written while printing a Box tree. Writes are recorded through
+//     ConsoleEditor::beginRecording() as fill commands, which cover a rectangle
+//     with a single character, and span commands, which copy a run of text to
+//     a single row. Fills of consecutive rows are merged into a single
+//     rectangle, so backgrounds and borders take a few commands each. A
+//     DisplayList can be replayed to the console screen, the write buffer, a
+//     CellSurface, or a frame of character rows, and can be saved to and
+//     loaded from a binary stream.
+//
+// Dependencies: InputEvent struct and CellSurface class.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include "ConsoleEditor/inputevent.h"
+#include "ConsoleEditor/cellsurface.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+class DisplayList {
+public:
+    //--------------------------------------------------------------------------
+    // Default constructor
+    DisplayList();
+
+    //--------------------------------------------------------------------------
+    // Remove all draw commands.
+    void clear();
+
+    //--------------------------------------------------------------------------
+    // Check if there are no draw commands.
+    bool empty() const;
+
+    //--------------------------------------------------------------------------
+    // Get the amount of draw commands.
+    int size() const;
+
+    //--------------------------------------------------------------------------
+    // Add a given amount of characters of text written starting at some
+    // position. Text of a single repeated character is added as a fill.
+    void addSpan(const Position& pos, const char text[], int length);
+
+    //--------------------------------------------------------------------------
+    // Add a fill of a rectangle with a single character. The fill is merged
+    // into a recent fill of the same columns and character that ends on the
+    // row above it.
+    void addFill(const Boundary& rect, char fill);
+
+    //--------------------------------------------------------------------------
+    // Replay the draw commands to the console screen or write buffer
+    // (indicated by the drawMode parameter).
+    void replay(bool drawMode) const;
+
+    //--------------------------------------------------------------------------
+    // Replay the draw commands into a CellSurface.
+    void replay(CellSurface& surface) const;
+
+    //--------------------------------------------------------------------------
+    // Replay the draw commands into a frame of character rows. Cells outside
+    // of the frame are ignored.
+    void replay(std::vector<std::vector<char>>& frame) const;
+
+    //--------------------------------------------------------------------------
+    // Write the draw commands to a binary stream.
+    // Returns false if the stream failed. Otherwise returns true.
+    bool save(std::ostream& out) const;
+
+    //--------------------------------------------------------------------------
+    // Replace the draw commands with those read from a binary stream written by
+    // save(). The DisplayList is left empty if the stream is not valid,
+    // including streams with commands larger or further from the origin than
+    // any console window.
+    // Returns false if the stream was not valid. Otherwise returns true.
+    bool load(std::istream& in);
+
+private:
+    // Amount of most recent commands searched for a fill to merge into
+    static const int MERGE_LOOKBACK = 4;
+
+    // Header of a saved DisplayList
+    static const char MAGIC[4];
+
+    // Largest width, height, or coordinate magnitude of a loaded command. A
+    // console window is never larger, and the end of a command cannot
+    // overflow an int.
+    static const int MAX_EXTENT = 32767;
+
+    // Amount of text pool characters read from a stream at once
+    static const int TEXT_CHUNK_SIZE = 64 * 1024;
+
+    // Command types
+    static const char FILL = 'F';
+    static const char SPAN = 'S';
+
+    // DrawCommand structure
+    // A single fill or span. A fill covers width by height cells with the
+    // fill character; a span copies width characters of the text pool
+    // starting at textIdx to a single row.
+    struct DrawCommand {
+        char type;
+        char fill;
+        int col;
+        int row;
+        int width;
+        int height;
+        int textIdx;
+    };
+
+    std::vector<DrawCommand> commands;
+
+    // Characters of every span, stored back to back
+    std::string text;
+
+    //--------------------------------------------------------------------------
+    // Call a print routine for each row of each draw command in list order.
+    // The routine receives the position of the row, its characters, and its
+    // length.
+    // Helper method for replay().
+    template <typename Print>
+    void forEachRow(Print print) const;
+
+    //--------------------------------------------------------------------------
+    // Write a 32-bit integer to a stream in little-endian byte order.
+    // Helper method for save().
+    static void writeInt(std::ostream& out, int value);
+
+    //--------------------------------------------------------------------------
+    // Read a 32-bit integer written by writeInt(). Returns false if the stream
+    // ended.
+    // Helper method for load().
+    static bool readInt(std::istream& in, int& value);
+
+};
+
+//------------------------------------------------------------------------------
+// Template forEachRow() definition.
+template <typename Print>
+void DisplayList::forEachRow(Print print) const {
+    std::string fillRow;
+    for (const DrawCommand& command : commands) {
+        if (command.type == SPAN) {
+            print(Position{ command.col, command.row },
+                    text.data() + command.textIdx, command.width);
+            continue;
+        }
+
+        fillRow.assign(command.width, command.fill);
+        for (int i = 0; i < command.height; ++i) {
+            print(Position{ command.col, command.row + i }, fillRow.data(),
+                    command.width);
+        }
+    }
+}
+
+}
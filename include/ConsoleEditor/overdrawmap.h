@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+// overdrawmap.h
+// Interface for the OverdrawMap class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: An OverdrawMap is a diagnostic grid that records how many times
+//     each cell of the console window was written to during a frame, along
+//     with the name of the writer that wrote each cell last. The map can be
+//     rendered as a heatmap of single character write counts or dumped as a
+//     text grid. An OverdrawMap is not thread safe and must be externally
+//     synchronized.
+//
+// Dependencies: InputEvent struct.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "ConsoleEditor/inputevent.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+class OverdrawMap {
+public:
+    //--------------------------------------------------------------------------
+    // Writer identifier of cells that were not written to by a named writer
+    static const int NO_WRITER = -1;
+
+    //--------------------------------------------------------------------------
+    // Default constructor
+    OverdrawMap();
+
+    //--------------------------------------------------------------------------
+    // Resize the map to a given width and height in character units and clear
+    // all recorded writes. Interned writer names are kept.
+    void reset(int width, int height);
+
+    //--------------------------------------------------------------------------
+    // Get the identifier of a writer name, interning the name if it has not
+    // been seen before.
+    int internWriter(const std::string& name);
+
+    //--------------------------------------------------------------------------
+    // Record a write of a given amount of cells starting at some position by
+    // a writer. Cells outside of the map are ignored.
+    void record(const Position& pos, int length, int writer);
+
+    //--------------------------------------------------------------------------
+    // Get the width of the map in character units.
+    int getWidth() const;
+
+    //--------------------------------------------------------------------------
+    // Get the height of the map in character units.
+    int getHeight() const;
+
+    //--------------------------------------------------------------------------
+    // Get the amount of times a cell was written to. Returns 0 if the position
+    // is outside of the map.
+    int getWrites(const Position& pos) const;
+
+    //--------------------------------------------------------------------------
+    // Get the name of the writer that wrote to a cell last. Returns an empty
+    // string if the cell was not written to by a named writer.
+    std::string getWriter(const Position& pos) const;
+
+    //--------------------------------------------------------------------------
+    // Get the highest amount of times any single cell was written to.
+    int getMaxWrites() const;
+
+    //--------------------------------------------------------------------------
+    // Get a row of the map as heatmap characters. Cells that were not written
+    // to are spaces, cells written to 1 to 9 times are the digits '1' to '9',
+    // and cells written to more often are '+'.
+    std::string getHeatRow(int row) const;
+
+    //--------------------------------------------------------------------------
+    // Dump the map as text. The dump holds the heatmap grid, followed by a grid
+    // of single character keys of the last writer of each cell and a legend
+    // that maps each key to its writer name.
+    std::string dump() const;
+
+private:
+    // Characters used as writer keys in a dump
+    static const char WRITER_KEYS[];
+
+    int width;
+    int height;
+
+    // Write count and last writer of each cell, stored row by row
+    std::vector<int> writes;
+    std::vector<int> lastWriters;
+
+    // Interned writer names, indexed by writer identifier
+    std::vector<std::string> writerNames;
+    std::unordered_map<std::string, int> writerIds;
+
+};
+
+}
@@ -23,8 +23,9 @@ namespace conu {
 //------------------------------------------------------------------------------
 // Align enumerator
 // Indicates the alignment of conent within a container. Align consists of
-// horizontal and vertical alignment.
-enum class Align {
+// horizontal and vertical alignment. Stored in a single byte to keep the Box
+// layout compact.
+enum class Align : unsigned char {
     // Horizontal alignment
     LEFT        = 1 << 0,   // Content alignment along left border
     CENTER      = 1 << 1,   // Content centered horizontally
@@ -17,14 +17,24 @@
 
 #include <functional>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 #include "ConsoleEditor/consoleeditor.h"
 #include "Menu/menumanager.h"
 #include "Menu/inputhookchain.h"
 #include "Box/box.h"
+#include "Box/boxregistry.h"
 #include "Box/BoxContainer/vertcontainer.h"
 
 namespace conu {
 
+// The default amount of buffered prints between full writes of the frame to
+// the window screen. Buffered prints only write the cells that differ from the
+// frame last written, so cells changed outside the Menu would otherwise never
+// be repaired. 300 prints is 10 seconds at the default frame rate of 30, and
+// costs one full write in every 300 prints.
+const int DEFAULT_FULL_PRINT_INTERVAL = 300;
+
 class MenuReplyActionFactory;
 
 //------------------------------------------------------------------------------
@@ -37,8 +47,13 @@ class MenuReplyActionFactory;
 //     backgroundTrans = false
 //     resizeScreen = false;
 //     useBuffering = true
+//     usePipelining = false
 //     useAutoPrint = true
+//     useArena = false
+//     trackOverdraw = false
+//     showOverdraw = false
 //     frameRate    = DEFAULT_FRAME_RATE
+//     fullPrintInterval = DEFAULT_FULL_PRINT_INTERVAL
 struct MenuOptions {
     bool printOnEnter;      // Print the contents of the Menu to the Window
                             //     screen upon entry of the Menu. If set to
@@ -63,15 +78,46 @@ struct MenuOptions {
     bool useBuffering;      // Use buffering to print the contents of the Menu
                             //     to the window screen. Otherwise, use drawing.
 
+    bool usePipelining;     // Print buffered frames to the window screen on a
+                            //     separate present thread, so the next frame
+                            //     can be built while the previous frame is
+                            //     still being written to the console.
+                            // Value ignored if useBuffering is false.
+
     bool useAutoPrint;      // Use the auto print system of MenuManager to
                             //     automatically print the contents of the Menu
                             //     at a regular frame rate.
+
+    bool useArena;          // Allocate the Boxes inserted into the Menu from a
+                            //     BoxArena owned by the Menu. The arena is
+                            //     released at once when the Menu is destroyed.
+                            //     Boxes inserted through an ItemAccessor or as
+                            //     a std::unique_ptr are not arena-allocated.
+
+    bool trackOverdraw;     // Record how many times each cell is written to
+                            //     during each print of the Menu, and the class
+                            //     of the Box that wrote each cell last. The
+                            //     map of the latest print is retrieved through
+                            //     getOverdraw(). Diagnostic use only; slows
+                            //     down printing.
+
+    bool showOverdraw;      // Print the overdraw of each print as a heatmap
+                            //     in place of the Menu contents. Each cell
+                            //     shows its write count from '1' to '9', or
+                            //     '+' for more. Implies trackOverdraw.
     
     int frameRate;          // The target frame rate of the Menu when using auto
                             //     print. Indicate DEFAULT_FRAME_RATE to use the
                             //     default frame rate of MenuManager.
                             // Value ignored if useAutoPrint is false.
 
+    int fullPrintInterval;  // The amount of buffered prints after which the
+                            //     whole frame is written to the window screen
+                            //     instead of only the cells that changed, to
+                            //     repair cells changed outside the Menu.
+                            //     Indicate 0 to never force a full write.
+                            // Value ignored if useBuffering is false.
+
     // Default constructor
     MenuOptions();
 
@@ -96,7 +142,12 @@ public:
 
     //--------------------------------------------------------------------------
     // Enter the Menu operation.
-    // Blocks until the Menu exits.
+    // If no Menu is active, blocks until the Menu and all Menus navigated to
+    //     from it exit, and returns the exit Reply of the Menu. Otherwise, the
+    //     Menu is pushed on top of the active Menu through the MenuManager
+    //     navigation scheduler and CONTINUE is returned immediately. The exit
+    //     Reply of the pushed Menu is then executed by the active Menu once
+    //     the pushed Menu exits.
     Reply enter();
 
     //--------------------------------------------------------------------------
@@ -127,6 +178,43 @@ public:
     // Box.
     void insert(int layer, const Box& inBox, const Position& pos);
 
+    //--------------------------------------------------------------------------
+    // Construct a Box of type T in place at the next available layer of the
+    // Menu, forwarding the given arguments to its constructor. The Box is
+    // marked as "dynamic".
+    // Returns a reference to the constructed Box.
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args);
+
+    //--------------------------------------------------------------------------
+    // Insert an owned Box into the Menu without copying it. Ownership is
+    // transferred to the Menu. Follows the layer and position rules of the
+    // copying insert methods.
+    // Returns a reference to the inserted Box.
+    template <typename T>
+    T& insert(std::unique_ptr<T> inBox);
+    template <typename T>
+    T& insert(int layer, std::unique_ptr<T> inBox);
+    template <typename T>
+    T& insert(int layer, std::unique_ptr<T> inBox, const Position& pos);
+
+    //--------------------------------------------------------------------------
+    // Insert a temporary Box into the Menu by moving it instead of copying it.
+    // Follows the layer and position rules of the copying insert methods.
+    // Returns a reference to the inserted Box.
+    template <typename T, typename = typename std::enable_if<
+            std::is_base_of<Box, T>::value
+            && !std::is_lvalue_reference<T>::value>::type>
+    T& insert(T&& inBox);
+    template <typename T, typename = typename std::enable_if<
+            std::is_base_of<Box, T>::value
+            && !std::is_lvalue_reference<T>::value>::type>
+    T& insert(int layer, T&& inBox);
+    template <typename T, typename = typename std::enable_if<
+            std::is_base_of<Box, T>::value
+            && !std::is_lvalue_reference<T>::value>::type>
+    T& insert(int layer, T&& inBox, const Position& pos);
+
     //--------------------------------------------------------------------------
     // Remove a Box from the Menu at a specified layer. 
     virtual void remove(int layer);
@@ -142,6 +230,25 @@ public:
     // recently inserted box was removed.
     virtual Box* getRecent() const;
 
+    //--------------------------------------------------------------------------
+    // Bind a name to a Box contained within the Menu, replacing any Box
+    // previously bound to the name.
+    // Returns a BoxHandle to the Box.
+    template <typename T>
+    BoxHandle<T> bind(const std::string& name, T& box);
+
+    //--------------------------------------------------------------------------
+    // Find a Box bound to a name within the Menu. Returns an empty BoxHandle if
+    // no Box is bound to the name, if the bound Box was destroyed, or if the
+    // Box is not of type T. The lookup is constant time; the returned
+    // BoxHandle should be stored instead of calling find() repeatedly.
+    template <typename T>
+    BoxHandle<T> find(const std::string& name) const;
+
+    //--------------------------------------------------------------------------
+    // Remove the binding of a name within the Menu.
+    void unbind(const std::string& name);
+
     //--------------------------------------------------------------------------
     // Set the alignment of the Menu contents.
     void setAlignment(Align alignment);
@@ -160,12 +267,18 @@ public:
     // Get the current options of the menu.
     const MenuOptions& getOptions() const;
 
+    //--------------------------------------------------------------------------
+    // Get the overdraw map recorded during the latest print of the Menu. The
+    // map is empty unless the trackOverdraw or showOverdraw option is set.
+    const OverdrawMap& getOverdraw() const;
+
     //--------------------------------------------------------------------------
     // Get a reference to the main vertical box container of the menu.
     VertContainer& getContainer();
 
     //--------------------------------------------------------------------------
-    // Set the Reply that is returned by the menu upon exit from enter().
+    // Set the Reply that is returned by the menu upon exit from enter(), or
+    // that is passed to the parent Menu upon exit if the Menu was navigated to.
     void setExitReply(Reply exitReply);
 
     //--------------------------------------------------------------------------
@@ -187,7 +300,24 @@ public:
     //     hook was not contained in the Menu.
     bool removeInputHook(HookHandle& handle);
 
+    //--------------------------------------------------------------------------
+    // Give the input focus of the Menu to a contained Box. While focused, each
+    //     input processed by the Menu is first passed to the Box through
+    //     focusInput(). Inputs ignored by the Box are dispatched normally. The
+    //     previously focused Box is notified through focusLost(). Pass nullptr
+    //     to clear the focus. The focus is cleared upon exit of the Menu, and
+    //     when the focused Box is destroyed.
+    void setFocus(Box* box);
+
+    //--------------------------------------------------------------------------
+    // Get a pointer to the Box holding the input focus of the Menu. Returns
+    //     nullptr if no Box is focused.
+    Box* getFocus() const;
+
 private:
+    // The MenuManager navigation scheduler runs the Menu stages
+    friend class MenuManager;
+
     // Static member data
     static ConsoleEditor& console;
     static MenuManager& manager;
@@ -196,23 +326,131 @@ private:
     // Member data
     std::mutex printLock;
     InputHookChain hookChain;
+    std::unique_ptr<BoxArena> arena;
     VertContainer container;
+    std::unordered_map<std::string, BoxHandle<Box>> boundBoxes;
+    BoxHandle<Box> focusBox;
     bool exitMenu;
     Reply exitReply;
     short screenWidth;
     short screenHeight;
     short prevScreenWidth;
     short prevScreenHeight;
+    int printsSinceFullWrite;
     MenuOptions options;
+    OverdrawMap overdraw;
+
+    //--------------------------------------------------------------------------
+    // Prepare the Menu for operation after being made the active Menu.
+    void onEnter();
+
+    //--------------------------------------------------------------------------
+    // Process a single user input. Called repeatedly by the MenuManager
+    // navigation scheduler while the Menu is active.
+    virtual void step();
+
+    //--------------------------------------------------------------------------
+    // Clean up the Menu after it exits operation, before it is removed as the
+    // active Menu.
+    void onExit();
+
+    //--------------------------------------------------------------------------
+    // Check if the Menu is marked to exit operation.
+    bool exiting() const;
 
     //--------------------------------------------------------------------------
-    // Primary operation loop of the Menu object.
-    virtual void entryLoop();
+    // Pass an InputEvent through the input hooks, the focused Box, and the
+    // Menu's VertContainer.
+    // Helper method for step().
+    void processInput(InputEvent& input);
+
+    //--------------------------------------------------------------------------
+    // Execute the MenuReplyAction corresponding to a Reply.
+    // Helper method for processInput().
+    void executeReply(Reply response);
 
     //--------------------------------------------------------------------------
     // Resize the screen if applicable.
     void resizeScreen();
 
+    //--------------------------------------------------------------------------
+    // Get the BoxArena to allocate inserted Boxes from, creating it on first
+    // use. Returns nullptr if the useArena option is not set.
+    BoxArena* getArena();
+
+    //--------------------------------------------------------------------------
+    // Stop overdraw tracking, store the overdraw map of the finished print,
+    // and print the map as a heatmap if the showOverdraw option is set.
+    // Helper method for print().
+    void finishOverdraw(bool drawMode);
+
 };
+//------------------------------------------------------------------------------
+template <typename T, typename... Args>
+T& Menu::emplace(Args&&... args) {
+    BoxArena::Scope scope(getArena());
+    return container.emplace<T>(std::forward<Args>(args)...);
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+T& Menu::insert(std::unique_ptr<T> inBox) {
+    return container.insert(std::move(inBox));
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+T& Menu::insert(int layer, std::unique_ptr<T> inBox) {
+    return container.insert(layer, std::move(inBox));
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+T& Menu::insert(int layer, std::unique_ptr<T> inBox, const Position& pos) {
+    return container.insert(layer, std::move(inBox), pos);
+}
+
+//------------------------------------------------------------------------------
+template <typename T, typename>
+T& Menu::insert(T&& inBox) {
+    BoxArena::Scope scope(getArena());
+    return container.insert(std::move(inBox));
+}
+
+//------------------------------------------------------------------------------
+template <typename T, typename>
+T& Menu::insert(int layer, T&& inBox) {
+    BoxArena::Scope scope(getArena());
+    return container.insert(layer, std::move(inBox));
+}
+
+//------------------------------------------------------------------------------
+template <typename T, typename>
+T& Menu::insert(int layer, T&& inBox, const Position& pos) {
+    BoxArena::Scope scope(getArena());
+    return container.insert(layer, std::move(inBox), pos);
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+BoxHandle<T> Menu::bind(const std::string& name, T& box) {
+    boundBoxes[name] = BoxHandle<Box>(box);
+    return BoxHandle<T>(box);
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+BoxHandle<T> Menu::find(const std::string& name) const {
+    auto it = boundBoxes.find(name);
+    if (it == boundBoxes.end()) {
+        return BoxHandle<T>();
+    }
+
+    T* box = dynamic_cast<T*>(it->second.get());
+    if (box == nullptr) {
+        return BoxHandle<T>();
+    }
+    return BoxHandle<T>(*box);
+}
 
 }
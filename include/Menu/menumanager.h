@@ -6,18 +6,25 @@
 // Description: The MenuManager object is responsible for automatically handling 
 //     auto printing on a per-Menu basis. Menus are inserted into the
 //     MenuManager in FILO behavior, where the most recently inserted Menu is
-//     the active Menu that is being managed for auto print. 
+//     the active Menu that is being managed for auto print. The MenuManager
+//     also runs the navigation scheduler, which operates the active Menu and
+//     switches between Menus within a single loop, and a TimerWheel of
+//     callbacks that are executed on the frame rate manager thread.
 // 
-// Dependencies: Menu class.
+// Dependencies: Menu and TimerWheel class.
 //------------------------------------------------------------------------------
 
 #pragma once
 
 #include <stack>
+#include <queue>
 #include <thread>
 #include <mutex>
 #include <chrono>
+#include <atomic>
 #include "ConsoleEditor/consoleeditor.h"
+#include "Flag/flag.h"
+#include "Menu/timerwheel.h"
 
 namespace conu {
 
@@ -33,6 +40,7 @@ const int INVALID_FRAME_RATE = -1;
 // Class declaration to prevent circular dependency.
 // Menu interface included in MenuManager implementation file. 
 class Menu;
+class Box;
 
 class MenuManager {
 public:
@@ -58,6 +66,8 @@ public:
 
     //--------------------------------------------------------------------------
     // Update the MenuManager to reflect any changes made to a Menu's options.
+    //     Blocks until the frame rate manager thread confirms the change, so
+    //     it must not be called from a timer callback.
     void update();
 
     //--------------------------------------------------------------------------
@@ -81,6 +91,90 @@ public:
     // No effect if there are no Menus.
     void refreshMenu();
 
+    //--------------------------------------------------------------------------
+    // Request a refresh of the topmost Menu. Requests are coalesced and handled
+    //     by the Menu once it has processed all pending input.
+    void requestRefresh();
+
+    //--------------------------------------------------------------------------
+    // Clear the pending refresh request. Returns true if a refresh was
+    //     requested since the previous call.
+    bool takeRefreshRequest();
+
+    //--------------------------------------------------------------------------
+    // Give the input focus of the topmost Menu to a Box. Pass nullptr to clear
+    //     the focus. No effect if there are no Menus.
+    void setFocus(Box* box);
+
+    //--------------------------------------------------------------------------
+    // Clear the input focus of the topmost Menu if it is held by the given
+    //     Box. No effect if there are no Menus.
+    void releaseFocus(const Box* box);
+
+    //--------------------------------------------------------------------------
+    // Run the navigation scheduler starting with a root Menu. The scheduler
+    //     operates the active Menu and applies navigation requests in a single
+    //     loop until the root Menu exits. Returns the exit Reply of the root
+    //     Menu. Called by Menu::enter() when no Menu is being navigated.
+    //     If another thread already runs the scheduler, the root Menu is
+    //     pushed onto that scheduler instead and a CONTINUE Reply is returned.
+    Reply navigate(Menu& root);
+
+    //--------------------------------------------------------------------------
+    // Check if the navigation scheduler is running.
+    bool navigating() const;
+
+    //--------------------------------------------------------------------------
+    // Request the navigation scheduler to enter a Menu on top of the active
+    //     Menu. When the entered Menu exits, its exit Reply is executed by the
+    //     Menu below it. No effect if the scheduler is not running. Requests
+    //     made from other threads are applied once the active Menu finishes
+    //     processing its current input.
+    void pushNavigation(Menu& menu);
+
+    //--------------------------------------------------------------------------
+    // Request the navigation scheduler to exit the active Menu and enter a
+    //     Menu in its place. The exit Reply of the replaced Menu is discarded.
+    //     No effect if the scheduler is not running.
+    void replaceNavigation(Menu& menu);
+
+    //--------------------------------------------------------------------------
+    // Request the navigation scheduler to exit the active Menu. Equivalent to
+    //     calling exit() on the active Menu.
+    void popNavigation();
+
+    //--------------------------------------------------------------------------
+    // Get the duration of the most recent Menu transition, measured from when
+    //     the transition was processed to when the new active Menu finished
+    //     entering.
+    std::chrono::microseconds getTransitionLatency() const;
+
+    //--------------------------------------------------------------------------
+    // Add a timer that calls a callback once after a given delay.
+    // Timer callbacks are executed on the frame rate manager thread while a
+    //     Menu is active, including Menus that do not use auto print. Timers
+    //     that expire together are executed as a single batch, after which
+    //     the topmost Menu is printed once. Callbacks must not call
+    //     pushMenu(), popMenu(), or update(), which wait on the frame rate
+    //     manager thread to pause or stop. Entering a Menu from a callback
+    //     requests the navigation scheduler to enter it instead.
+    // Returns a handle to the added timer to use for removal.
+    TimerHandle addTimer(std::chrono::milliseconds delay,
+            std::function<void()> callback);
+
+    //--------------------------------------------------------------------------
+    // Add a timer that calls a callback repeatedly at a given interval until
+    //     removed. Intervals that are missed entirely are skipped. See
+    //     addTimer() for the conditions that timer callbacks are executed in.
+    // Returns a handle to the added timer to use for removal.
+    TimerHandle addRepeatingTimer(std::chrono::milliseconds interval,
+            std::function<void()> callback);
+
+    //--------------------------------------------------------------------------
+    // Remove an added timer given the timer's handle.
+    // Returns false if the timer was not found. Otherwise returns true.
+    bool removeTimer(TimerHandle& handle);
+
 private:
     // ManagerState enumerator to indicate the target/current state of the 
     //     frame rate manager.
@@ -90,6 +184,12 @@ private:
         PAUSED
     };
 
+    // NavRequest structure to store a pending navigation request.
+    struct NavRequest {
+        bool replace;
+        Menu* menu;
+    };
+
     // Singleton static instance
     static MenuManager instance;
 
@@ -102,6 +202,18 @@ private:
     bool restoreConsoleOnEmpty;
     std::stack<Menu*> menuStack;
     std::chrono::milliseconds frameInterval;
+    std::atomic<bool> refreshRequested;
+
+    // Navigation scheduler members
+    std::atomic<bool> navActive;
+    int navDepth;
+    std::queue<NavRequest> navRequests;
+    std::mutex navLock;
+    std::chrono::microseconds transitionLatency;
+
+    // Timer members
+    TimerWheel timerWheel;
+    bool timersChanged;
 
     // Frame rate manager thread members
     std::thread frameRateManagerThread;
@@ -110,7 +222,9 @@ private:
 
     // Thread control
     std::mutex stackLock;
+    std::mutex timerLock;
     std::mutex managerLock;
+    std::mutex updateLock;
     std::condition_variable managerCV;
 
     //--------------------------------------------------------------------------
@@ -122,9 +236,15 @@ private:
     void frameRateManager();
 
     //--------------------------------------------------------------------------
-    // Get the current time since epoch in milliseconds.
-    // Helper method for frameRateManager().
-    std::chrono::milliseconds getTimeMS() const;
+    // Add a timer to the TimerWheel and wake the frame rate manager to account
+    // for the new timer.
+    // Helper method for addTimer() and addRepeatingTimer().
+    TimerHandle scheduleTimer(std::chrono::milliseconds delay,
+            std::chrono::milliseconds interval, std::function<void()> callback);
+
+    //--------------------------------------------------------------------------
+    // Wake the frame rate manager thread from its sleep.
+    void wakeFrameRateManager();
 
     //--------------------------------------------------------------------------
     // Start the frame rate manager thread in the indicated state.
@@ -142,6 +262,22 @@ private:
     // Resume the frame rate manager that is in the paused state.
     void resumeFrameRateManager();
 
+    //--------------------------------------------------------------------------
+    // Get the topmost Menu for operation by the navigation scheduler.
+    // Helper method for navigate().
+    Menu* activeMenu();
+
+    //--------------------------------------------------------------------------
+    // Make a Menu the active Menu and enter it.
+    // Helper method for navigate().
+    void enterMenu(Menu& menu);
+
+    //--------------------------------------------------------------------------
+    // Exit the active Menu and remove it from the MenuManager. Returns the
+    // exit Reply of the Menu.
+    // Helper method for navigate().
+    Reply leaveMenu();
+
 };
 
 }
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+// timerwheel.h
+// Interface for the TimerWheel class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: A TimerWheel is a hashed timing wheel that stores one-shot and
+//     repeating timer callbacks. Timers are hashed into a fixed ring of slots
+//     by the millisecond tick they are due, so adding, removing, and expiring
+//     a timer does not depend on the amount of stored timers. Expired timer
+//     callbacks are collected in batches to be executed by the caller.
+//     A TimerWheel is not thread safe and must be externally synchronized.
+//
+// Dependencies: None.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <vector>
+#include <unordered_map>
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+// TimerHandle class
+// Defines a handle to a specific timer within a TimerWheel object.
+// Used to remove an added timer from a TimerWheel.
+class TimerHandle {
+    friend class TimerWheel;
+
+public:
+    //--------------------------------------------------------------------------
+    // Default constructor
+    TimerHandle();
+
+    //--------------------------------------------------------------------------
+    // Parameter constructor
+    TimerHandle(unsigned inId);
+
+private:
+    // Identifier of the timer. 0 indicates an invalid handle
+    unsigned timerId;
+
+};
+
+//------------------------------------------------------------------------------
+class TimerWheel {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    //--------------------------------------------------------------------------
+    // Default constructor
+    TimerWheel();
+
+    //--------------------------------------------------------------------------
+    // Add a timer that calls a callback once at a given time point. If the
+    //     interval is greater than zero, the timer repeats at each interval
+    //     after the first call until removed.
+    // Returns a handle to the added timer to use for removal.
+    TimerHandle addTimer(Clock::time_point due,
+            std::chrono::milliseconds interval, std::function<void()> callback);
+
+    //--------------------------------------------------------------------------
+    // Remove an added timer given the timer's handle.
+    // Returns false if the timer was not found. Otherwise returns true.
+    bool removeTimer(TimerHandle& handle);
+
+    //--------------------------------------------------------------------------
+    // Collect the callbacks of all timers due at or before a given time point.
+    //     One-shot timers are removed and repeating timers are rescheduled to
+    //     their next interval after the time point.
+    // Returns the amount of collected callbacks.
+    int collectExpired(Clock::time_point now,
+            std::vector<std::function<void()>>& expired);
+
+    //--------------------------------------------------------------------------
+    // Get the time point that the earliest timer is due. Returns false if
+    //     there are no timers. Otherwise returns true.
+    bool nextDue(Clock::time_point& due) const;
+
+    //--------------------------------------------------------------------------
+    // Check if there are no timers.
+    bool empty() const;
+
+    //--------------------------------------------------------------------------
+    // Remove all timers.
+    void clear();
+
+private:
+    // Amount of slots in the wheel. Each slot covers a single tick
+    static const int SLOT_COUNT = 512;
+
+    // Timer structure
+    // Helper structure for the data of a single timer
+    struct Timer {
+        long long dueTick;
+        long long intervalTicks;
+        std::function<void()> callback;
+    };
+
+    // Time point that tick 0 refers to
+    Clock::time_point origin;
+
+    // Tick of the slot that is expired next
+    long long currTick;
+
+    // Timer storage and the ids of the timers hashed into each slot
+    std::unordered_map<unsigned, Timer> timers;
+    std::vector<std::vector<unsigned>> slots;
+    unsigned nextId;
+
+    //--------------------------------------------------------------------------
+    // Convert a time point into a millisecond tick since the origin. The tick
+    // is rounded down unless indicated to round up.
+    long long toTick(Clock::time_point time, bool roundUp) const;
+
+    //--------------------------------------------------------------------------
+    // Hash a timer id into the slot of a given tick.
+    void insertIntoSlot(unsigned id, long long tick);
+
+};
+
+}
@@ -20,8 +20,11 @@
 #include "Box/BoxContainer/boxcontainer.h"
 #include "Box/BoxContainer/horizcontainer.h"
 #include "Box/BoxContainer/vertcontainer.h"
+#include "Box/BoxContainer/virtualcontainer.h"
+#include "Box/BoxContainer/renderpool.h"
 #include "Box/ContentBox/spacer.h"
 #include "Box/ContentBox/graphic.h"
+#include "Box/ContentBox/graphicpainter.h"
 #include "Box/ContentBox/TextBox/textbox.h"
 #include "Box/ContentBox/TextBox/livetextbox.h"
 #include "Box/ContentBox/TextBox/entrytextbox.h"
@@ -13,10 +13,11 @@
 //     aligned within the Box given specified horizontal and vertical alignment
 //     flags.
 // 
-// Dependencies: EditConsole class and Flag enumerators.
+// Dependencies: EditConsole class, BoxArena class, and Flag enumerators.
 //------------------------------------------------------------------------------
 
 #include "Box/box.h"
+#include "Box/boxregistry.h"
 
 namespace conu {
 
@@ -30,6 +31,10 @@ const int Box::DEFAULT_WIDTH = 5;
 const int Box::DEFAULT_HORIZ_BORDER_SIZE = 0;
 const int Box::DEFAULT_VERT_BORDER_SIZE = 0;
 const BorderFill Box::DEFAULT_BORDER_FILL = BorderFill{ ' ', ' ', ' ', ' ' };
+const unsigned Box::MAX_CACHED_BASE_ROWS = 256;
+thread_local std::unordered_map<unsigned long long, Box::BaseRows>
+        Box::baseRowCache;
+std::atomic<unsigned> Box::nextId{ 1 };
 
 //------------------------------------------------------------------------------
 Box::Box() :
@@ -40,12 +45,17 @@ Box::Box() :
     actualWidth{ DEFAULT_HEIGHT },
     horizBorderSize{ DEFAULT_HORIZ_BORDER_SIZE },
     vertBorderSize{ DEFAULT_VERT_BORDER_SIZE },
-    borderFill{ DEFAULT_BORDER_FILL },
     targetPos{ DEFAULT_POS },
     savedBound{ DEFAULT_BOUND },
     alignment{ Align::LEFT | Align::MIDDLE },
     drawn{ false },
-    transparent{ false } {
+    transparent{ false },
+    indexed{ false },
+    retained{ false },
+    opaqueBase{ false },
+    boxId{ nextId++ },
+    parent{ nullptr },
+    cold{ nullptr } {
 
 }
 
@@ -54,16 +64,21 @@ Box::Box(int width, int height) :
     absolutePos{ DEFAULT_POS },
     targetHeight{ height },
     targetWidth{ width },
-    actualHeight{ height },
-    actualWidth{ width },
+    actualHeight{ toStoredSize(height) },
+    actualWidth{ toStoredSize(width) },
     horizBorderSize{ DEFAULT_HORIZ_BORDER_SIZE },
     vertBorderSize{ DEFAULT_VERT_BORDER_SIZE },
-    borderFill{ DEFAULT_BORDER_FILL },
     targetPos{ DEFAULT_POS },
     savedBound{ DEFAULT_BOUND },
     alignment{ Align::LEFT | Align::MIDDLE },
     drawn{ false },
-    transparent{ false } {
+    transparent{ false },
+    indexed{ false },
+    retained{ false },
+    opaqueBase{ false },
+    boxId{ nextId++ },
+    parent{ nullptr },
+    cold{ nullptr } {
 
     // Cannot have negative width or height
     if (width < 0) {
@@ -76,9 +91,92 @@ Box::Box(int width, int height) :
     }
 }
 
+//------------------------------------------------------------------------------
+Box::Box(const Box& copy) :
+    absolutePos{ copy.absolutePos },
+    targetHeight{ copy.targetHeight },
+    targetWidth{ copy.targetWidth },
+    actualHeight{ copy.actualHeight },
+    actualWidth{ copy.actualWidth },
+    horizBorderSize{ copy.horizBorderSize },
+    vertBorderSize{ copy.vertBorderSize },
+    targetPos{ copy.targetPos },
+    savedBound{ copy.savedBound },
+    alignment{ copy.alignment },
+    drawn{ copy.drawn },
+    transparent{ copy.transparent },
+    indexed{ false },
+    retained{ copy.retained },
+    opaqueBase{ copy.opaqueBase },
+    boxId{ nextId++ },
+    parent{ nullptr },
+    cold{ nullptr } {
+
+    if (copy.cold != nullptr) {
+        getColdState().borderFill = copy.cold->borderFill;
+        if (copy.retained) {
+            cold->surface.reset(new RetainedSurface());
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+Box& Box::operator = (const Box& copy) {
+    absolutePos = copy.absolutePos;
+    targetHeight = copy.targetHeight;
+    targetWidth = copy.targetWidth;
+    actualHeight = copy.actualHeight;
+    actualWidth = copy.actualWidth;
+    horizBorderSize = copy.horizBorderSize;
+    vertBorderSize = copy.vertBorderSize;
+    if (copy.cold != nullptr) {
+        getColdState().borderFill = copy.cold->borderFill;
+    }
+    else if (cold != nullptr) {
+        cold->borderFill = DEFAULT_BORDER_FILL;
+    }
+    targetPos = copy.targetPos;
+    savedBound = copy.savedBound;
+    alignment = copy.alignment;
+    drawn = copy.drawn;
+    transparent = copy.transparent;
+    retainSurface(copy.retained);
+
+    invalidateLayout();
+    return *this;
+}
+
 //------------------------------------------------------------------------------
 Box::~Box() {
+    if (indexed) {
+        BoxRegistry::getInstance().unindex(boxId);
+    }
+}
 
+//------------------------------------------------------------------------------
+void* Box::operator new(std::size_t size) {
+    BoxArena* arena = BoxArena::getActive();
+    if (arena != nullptr) {
+        return arena->allocate(size);
+    }
+    return ::operator new(size);
+}
+
+//------------------------------------------------------------------------------
+void Box::operator delete(void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    // Boxes carry no record of their arena; the arena is found from the
+    // address, which is free while no BoxArena exists
+    BoxArena* arena = BoxArena::findOwner(ptr);
+    if (arena != nullptr) {
+        arena->release();
+    }
+    else {
+        ::operator delete(ptr);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -90,14 +188,63 @@ Position Box::getPosition() const {
     return absolutePos;
 }
 
+//------------------------------------------------------------------------------
+void Box::invalidateLayout() {
+    invalidateSurface();
+    discardMeasure();
+
+    // Stop at the first container without a cached size. Containers are only
+    // measured after their contents, so its ancestors have no cached size.
+    Box* ancestor = parent;
+    while (ancestor != nullptr && ancestor->discardMeasure()) {
+        ancestor = ancestor->parent;
+    }
+}
+
+//------------------------------------------------------------------------------
+void Box::retainSurface(bool retain) {
+    // The surface is allocated up front and kept once allocated, so that it is
+    // never replaced or freed while the Box is printed on another thread
+    if (retain && getSurface() == nullptr) {
+        getColdState().surface.reset(new RetainedSurface());
+    }
+    retained = retain;
+    invalidateSurface();
+}
+
+//------------------------------------------------------------------------------
+bool Box::retainsSurface() const {
+    return retained;
+}
+
+//------------------------------------------------------------------------------
+void Box::invalidateSurface() {
+    for (Box* box = this; box != nullptr; box = box->parent) {
+        RetainedSurface* surface = box->getSurface();
+        if (surface != nullptr) {
+            surface->valid = false;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+Reply Box::focusInput(InputEvent) {
+    return Reply::IGNORED;
+}
+
+//------------------------------------------------------------------------------
+void Box::focusLost() {
+
+}
+
 //------------------------------------------------------------------------------
 Reply Box::draw(Position pos, Boundary container) {
-    return printProtocol(pos, container, true);
+    return runPrintProtocol(pos, container, true);
 }
 
 //------------------------------------------------------------------------------
 Reply Box::buffer(Position pos, Boundary container) {
-    return printProtocol(pos, container, false);
+    return runPrintProtocol(pos, container, false);
 }
 
 //------------------------------------------------------------------------------
@@ -106,7 +253,7 @@ Reply Box::redraw() {
         return Reply::FAILED;
     }
 
-    return printProtocol(targetPos, savedBound, true);
+    return runPrintProtocol(targetPos, savedBound, true);
 }
 
 //------------------------------------------------------------------------------
@@ -115,7 +262,16 @@ Reply Box::rebuffer() {
         return Reply::FAILED;
     }
 
-    return printProtocol(targetPos, savedBound, false);
+    return runPrintProtocol(targetPos, savedBound, false);
+}
+
+//------------------------------------------------------------------------------
+Reply Box::record(DisplayList& list, Position pos, Boundary container) {
+    list.clear();
+    console.beginRecording(list);
+    Reply reply = buffer(pos, container);
+    console.endRecording();
+    return reply;
 }
 
 //------------------------------------------------------------------------------
@@ -129,10 +285,12 @@ void Box::setDimensions(int width, int height) {
     }
 
     targetWidth = width;
-    actualWidth = width;
+    actualWidth = toStoredSize(width);
 
     targetHeight = height;
-    actualHeight = height;
+    actualHeight = toStoredSize(height);
+
+    invalidateLayout();
 }
 
 //------------------------------------------------------------------------------
@@ -146,54 +304,69 @@ void Box::setDimensions(Position dimensions) {
     }
 
     targetWidth = dimensions.col;
-    actualWidth = dimensions.col;
+    actualWidth = toStoredSize(dimensions.col);
 
     targetHeight = dimensions.row;
-    actualHeight = dimensions.row;
+    actualHeight = toStoredSize(dimensions.row);
+
+    invalidateLayout();
 }
 
 //------------------------------------------------------------------------------
 void Box::setBorderSize(int size) {
-    horizBorderSize = size;
-    vertBorderSize = size;
+    horizBorderSize = toStoredSize(size);
+    vertBorderSize = toStoredSize(size);
+    invalidateLayout();
 }
 
 //------------------------------------------------------------------------------
 void Box::setBorderSize(BorderSize size) {
-    horizBorderSize = size.horizontal;
-    vertBorderSize = size.vertical;
+    horizBorderSize = toStoredSize(size.horizontal);
+    vertBorderSize = toStoredSize(size.vertical);
+    invalidateLayout();
 }
 
 
 //------------------------------------------------------------------------------
 void Box::setHorizontalBorderSize(int size) {
-    horizBorderSize = size;
+    horizBorderSize = toStoredSize(size);
+    invalidateLayout();
 }
 
 //------------------------------------------------------------------------------
 void Box::setVerticalBorderSize(int size) {
-    vertBorderSize = size;
+    vertBorderSize = toStoredSize(size);
+    invalidateLayout();
 }
 
 //------------------------------------------------------------------------------
 void Box::setBorderFill(char fill) {
-    borderFill.left = fill;
-    borderFill.top = fill;
-    borderFill.right = fill;
-    borderFill.bottom = fill;
+    setBorderFill(BorderFill{ fill, fill, fill, fill });
 }
 
 //------------------------------------------------------------------------------
 void Box::setBorderFill(const BorderFill& fill) {
+    // The default fill does not need the out of line data
+    bool isDefault = fill.left == DEFAULT_BORDER_FILL.left
+            && fill.top == DEFAULT_BORDER_FILL.top
+            && fill.right == DEFAULT_BORDER_FILL.right
+            && fill.bottom == DEFAULT_BORDER_FILL.bottom;
+    if (isDefault && cold == nullptr) {
+        return;
+    }
+
+    BorderFill& borderFill = getColdState().borderFill;
     borderFill.left = fill.left;
     borderFill.top = fill.top;
     borderFill.right = fill.right;
     borderFill.bottom = fill.bottom;
+    invalidateSurface();
 }
 
 //------------------------------------------------------------------------------
 void Box::setAlignment(Align inAlign) {
     alignment = inAlign;
+    invalidateSurface();
 }
 
 //------------------------------------------------------------------------------
@@ -218,13 +391,21 @@ BorderSize Box::getBorderSize() const {
 
 //------------------------------------------------------------------------------
 BorderFill Box::getBorderFill() const {
-    return borderFill;
+    return cold != nullptr ? cold->borderFill : DEFAULT_BORDER_FILL;
 }
 
 
 //------------------------------------------------------------------------------
 void Box::backgroundTransparent(bool transparent) {
-    this->transparent = transparent;
+    if (this->transparent != transparent) {
+        this->transparent = transparent;
+        invalidateSurface();
+    }
+}
+
+//------------------------------------------------------------------------------
+bool Box::discardMeasure() {
+    return false;
 }
 
 //------------------------------------------------------------------------------
@@ -247,6 +428,11 @@ bool Box::posInBounds(Position pos) const {
 }
 
 ////------------------------------------------------------------------------------
+unsigned Box::getId() const {
+    return boxId;
+}
+
+//------------------------------------------------------------------------------
 //void Box::calculateActualDimAndPos(Position pos, Boundary container) {
 //    Position winDim = console.getWindowDimensions();
 //    int colOffset;
@@ -332,14 +518,24 @@ bool Box::posInBounds(Position pos) const {
 
 //------------------------------------------------------------------------------
 void Box::calculateActualDimAndPos(Position pos, Boundary container) {
-    Position winDim = console.getWindowDimensions();
-    int colOffset;
-    int rowOffset;
-
     // Save pos and container
     targetPos = pos;
     savedBound = container;
 
+    Position fitPos{ 0, 0 };
+    int fitWidth = 0;
+    int fitHeight = 0;
+    fitToContainer(pos, clipToWindow(container), targetWidth, targetHeight,
+            fitPos, fitWidth, fitHeight);
+    absolutePos = fitPos;
+    actualWidth = toStoredSize(fitWidth);
+    actualHeight = toStoredSize(fitHeight);
+}
+
+//------------------------------------------------------------------------------
+Boundary Box::clipToWindow(Boundary container) {
+    Position winDim = console.getWindowDimensions();
+
     // Bounds check container
     if (container.top < 0) {
         container.top = 0;
@@ -354,117 +550,135 @@ void Box::calculateActualDimAndPos(Position pos, Boundary container) {
         container.right = winDim.col;
     }
 
+    return container;
+}
+
+//------------------------------------------------------------------------------
+void Box::skipPrint(Position pos, Boundary container) {
+    // A retained surface does not restore the dimensions of a skipped Box
+    RetainedSurface* surface = getSurface();
+    if (surface != nullptr) {
+        surface->valid = false;
+    }
+    targetPos = pos;
+    savedBound = container;
+    absolutePos = pos;
+    actualWidth = 0;
+    actualHeight = 0;
+    drawn = true;
+}
+
+//------------------------------------------------------------------------------
+short Box::toStoredSize(int size) {
+    return PackedPosition::toCoord(size);
+}
+
+//------------------------------------------------------------------------------
+void Box::fitToContainer(Position pos, const Boundary& container, int width,
+        int height, Position& fitPos, int& fitWidth, int& fitHeight) {
+    int colOffset;
+    int rowOffset;
+
     // Get absolute origin position of the Box
-    absolutePos.col = pos.col;
-    absolutePos.row = pos.row;
+    fitPos.col = pos.col;
+    fitPos.row = pos.row;
 
     // Check if the starting position is above/behind container origin point or
     // the console origin point
-    if (absolutePos.col < container.left) {
-        absolutePos.col = container.left;
+    if (fitPos.col < container.left) {
+        fitPos.col = container.left;
     }
-    if (absolutePos.row < container.top) {
-        absolutePos.row = container.top;
+    if (fitPos.row < container.top) {
+        fitPos.row = container.top;
     }
 
     // Calculate offsets with overflow handling
-    if (absolutePos.col + targetWidth >= 0) {
+    if (fitPos.col + width >= 0) {
         // Normal calculation
-        colOffset = (absolutePos.col + targetWidth - 1) - container.right;
-        actualWidth = targetWidth;
+        colOffset = (fitPos.col + width - 1) - container.right;
+        fitWidth = width;
     }
     else {
         // Prevent overflow
-        colOffset = targetWidth - container.right;
-        actualWidth = targetWidth - absolutePos.col;
+        colOffset = width - container.right;
+        fitWidth = width - fitPos.col;
     }
-    if (absolutePos.row + targetHeight >= 0) {
+    if (fitPos.row + height >= 0) {
         // Normal calculation
-        rowOffset = (absolutePos.row + targetHeight - 1) - container.bottom;
-        actualHeight = targetHeight;
+        rowOffset = (fitPos.row + height - 1) - container.bottom;
+        fitHeight = height;
     }
     else {
         // Prevent overflow
-        rowOffset = targetHeight - container.bottom;
-        actualHeight = targetHeight - absolutePos.row;
+        rowOffset = height - container.bottom;
+        fitHeight = height - fitPos.row;
     }
 
     // Calculate actual col and width
     if (colOffset > 0) {
-        absolutePos.col -= colOffset;
+        fitPos.col -= colOffset;
 
         // Check if width needs to be resized
-        if (absolutePos.col < container.left) {
-            colOffset = container.left - absolutePos.col; // Reusing colOffset
-            absolutePos.col += colOffset;
-            actualWidth -= colOffset;
+        if (fitPos.col < container.left) {
+            colOffset = container.left - fitPos.col; // Reusing colOffset
+            fitPos.col += colOffset;
+            fitWidth -= colOffset;
         }
     }
 
     // Calculate actual row and height
     if (rowOffset > 0) {
-        absolutePos.row -= rowOffset;
+        fitPos.row -= rowOffset;
 
         // Check if height needs to be resized
-        if (absolutePos.row < container.top) {
-            rowOffset = container.top - absolutePos.row; // Reusing rowOffset
-            absolutePos.row += rowOffset;
-            actualHeight -= rowOffset;
+        if (fitPos.row < container.top) {
+            rowOffset = container.top - fitPos.row; // Reusing rowOffset
+            fitPos.row += rowOffset;
+            fitHeight -= rowOffset;
         }
     }
 
     // Check actual width and height for negative
-    if (actualWidth < 0) {
-        actualWidth = 0;
+    if (fitWidth < 0) {
+        fitWidth = 0;
     }
-    if (actualHeight < 0) {
-        actualHeight = 0;
+    if (fitHeight < 0) {
+        fitHeight = 0;
     }
 }
 
 //------------------------------------------------------------------------------
 void Box::printBase(Position pos, Boundary container, bool drawMode) {
     calculateActualDimAndPos(pos, container);
-    std::string topBorderRow(actualWidth, borderFill.top);
-    std::string bottomBorderRow(actualWidth, borderFill.bottom);
-    std::string internalRow(actualWidth, ' ');
-    Position currPos = absolutePos;
-
-    // Add vertical borders
-    for (int i = 0; i < vertBorderSize && i < actualWidth; ++i) {
-        topBorderRow[i] = borderFill.left;
-        bottomBorderRow[i] = borderFill.left;
-        internalRow[i] = borderFill.left;
+    paintBase(drawMode, nullptr);
+}
 
-        topBorderRow[actualWidth - i - 1] = borderFill.right;
-        bottomBorderRow[actualWidth - i - 1] = borderFill.right;
-        internalRow[actualWidth - i - 1] = borderFill.right;
+//------------------------------------------------------------------------------
+void Box::paintBase(bool drawMode, const std::vector<char>* coveredCells) {
+    if (transparent && horizBorderSize == 0 && vertBorderSize == 0) {
+        return;
     }
 
+    const BaseRows& rows = getBaseRows();
+    const std::string& topBorderRow = rows.top;
+    const std::string& bottomBorderRow = rows.bottom;
+    const std::string& internalRow = rows.internal;
+    Position currPos = absolutePos;
+
     // Only print border if transparent
     if (transparent) {
-        if (horizBorderSize == 0 && vertBorderSize == 0) {
-            return;
-        }
-
         for (int i = 0; i < actualHeight; ++i) {
             if (i + 1 <= horizBorderSize) {
-                printLine(currPos, topBorderRow.c_str(), drawMode);
+                printLine(currPos, topBorderRow.data(), actualWidth, drawMode);
             }
             else if (actualHeight - i <= horizBorderSize) {
-                printLine(currPos, bottomBorderRow.c_str(), drawMode);
-            }
-            else {
-                // Print vertical borders
-                int maxCol = currPos.col + actualWidth;
-                for (int j = 0; j < vertBorderSize; ++j) {
-                    char temp[2] = { borderFill.left, '\0' };
-                    printLine(Position{ currPos.col + i, currPos.row }, temp,
+                printLine(currPos, bottomBorderRow.data(), actualWidth,
                         drawMode);
-
-                    temp[0] = borderFill.right;
-                    printLine(Position{ maxCol - i, currPos.row }, temp, drawMode);
-                }
+            }
+            else if (vertBorderSize > 0) {
+                // Print vertical borders, leaving the interior untouched
+                printEdges(currPos, internalRow.data(), actualWidth,
+                        vertBorderSize, drawMode);
             }
             ++currPos.row;
         }
@@ -475,18 +689,151 @@ void Box::printBase(Position pos, Boundary container, bool drawMode) {
     // Otherwise print opaque Box base to console
     for (int i = 0; i < actualHeight; ++i) {
         if (i + 1 <= horizBorderSize) {
-            printLine(currPos, topBorderRow.c_str(), drawMode);
+            printLine(currPos, topBorderRow.data(), actualWidth, drawMode);
         }
         else if (actualHeight - i <= horizBorderSize) {
-            printLine(currPos, bottomBorderRow.c_str(), drawMode);
+            printLine(currPos, bottomBorderRow.data(), actualWidth,
+                    drawMode);
+        }
+        else if (coveredCells != nullptr && static_cast<int>(
+                coveredCells->size()) >= (i + 1) * actualWidth) {
+            // Cells painted over by content are skipped; each remaining run
+            // of the row is painted as a single span
+            const char* covered = coveredCells->data() + i * actualWidth;
+            int col = 0;
+            while (col < actualWidth) {
+                if (covered[col]) {
+                    ++col;
+                    continue;
+                }
+
+                int runEnd = col;
+                while (runEnd < actualWidth && !covered[runEnd]) {
+                    ++runEnd;
+                }
+                printLine(Position{ currPos.col + col, currPos.row },
+                        internalRow.data() + col, runEnd - col, drawMode);
+                col = runEnd;
+            }
         }
         else {
-            printLine(currPos, internalRow.c_str(), drawMode);
+            printLine(currPos, internalRow.data(), actualWidth, drawMode);
         }
         ++currPos.row;
     }
 }
 
+//------------------------------------------------------------------------------
+const Box::BaseRows& Box::getBaseRows() const {
+    const BorderFill& borderFill = cold != nullptr ? cold->borderFill
+            : DEFAULT_BORDER_FILL;
+    unsigned long long key = static_cast<unsigned short>(actualWidth);
+    key = (key << 16) | static_cast<unsigned short>(vertBorderSize);
+    key = (key << 8) | static_cast<unsigned char>(borderFill.left);
+    key = (key << 8) | static_cast<unsigned char>(borderFill.top);
+    key = (key << 8) | static_cast<unsigned char>(borderFill.right);
+    key = (key << 8) | static_cast<unsigned char>(borderFill.bottom);
+
+    auto cached = baseRowCache.find(key);
+    if (cached != baseRowCache.end()) {
+        return cached->second;
+    }
+
+    // Keep the cache bounded if many differently sized Boxes are printed
+    if (baseRowCache.size() >= MAX_CACHED_BASE_ROWS) {
+        baseRowCache.clear();
+    }
+
+    int width = actualWidth < 0 ? 0 : actualWidth;
+    BaseRows& rows = baseRowCache[key];
+    rows.top.assign(width, borderFill.top);
+    rows.bottom.assign(width, borderFill.bottom);
+    rows.internal.assign(width, ' ');
+
+    // Add vertical borders
+    for (int i = 0; i < vertBorderSize && i < width; ++i) {
+        rows.top[i] = borderFill.left;
+        rows.bottom[i] = borderFill.left;
+        rows.internal[i] = borderFill.left;
+
+        rows.top[width - i - 1] = borderFill.right;
+        rows.bottom[width - i - 1] = borderFill.right;
+        rows.internal[width - i - 1] = borderFill.right;
+    }
+
+    return rows;
+}
+
+//------------------------------------------------------------------------------
+Box::ColdState& Box::getColdState() {
+    if (cold == nullptr) {
+        cold.reset(new ColdState{ DEFAULT_BORDER_FILL, nullptr });
+    }
+    return *cold;
+}
+
+//------------------------------------------------------------------------------
+Box::RetainedSurface* Box::getSurface() const {
+    return cold != nullptr ? cold->surface.get() : nullptr;
+}
+
+//------------------------------------------------------------------------------
+Reply Box::runPrintProtocol(Position pos, Boundary container, bool drawMode) {
+    bool tracking = console.overdrawTracking();
+    int prevWriter = OverdrawMap::NO_WRITER;
+    if (tracking) {
+        prevWriter = console.setCellWriter(getClassName());
+    }
+
+    Reply reply = retained ? printRetained(pos, container, drawMode)
+            : printProtocol(pos, container, drawMode);
+
+    if (tracking) {
+        console.restoreCellWriter(prevWriter);
+    }
+    return reply;
+}
+
+//------------------------------------------------------------------------------
+Reply Box::printRetained(Position pos, Boundary container, bool drawMode) {
+    // The position and container are compared in the 16-bit form they were
+    // saved in
+    Boundary clip = clipToWindow(container);
+    PackedPosition packedPos(pos);
+    RetainedSurface* surface = getSurface();
+    if (surface != nullptr && surface->valid && drawn
+            && packedPos.col == targetPos.col && packedPos.row == targetPos.row
+            && sameBoundary(PackedBoundary(container), savedBound)
+            && sameBoundary(clip, surface->cells.getClip())) {
+        surface->cells.forEachSpan([this, drawMode](const Position& spanPos,
+                const char text[], int length) {
+                printLine(spanPos, text, length, drawMode);
+            });
+        return Reply::CONTINUE;
+    }
+
+    if (surface == nullptr) {
+        surface = new RetainedSurface();
+        getColdState().surface.reset(surface);
+    }
+    surface->cells.reset(clip);
+
+    // Mark the surface valid before printing so that content invalidated
+    // while printing is printed again on the next print
+    surface->valid = true;
+    console.beginCapture(surface->cells);
+    Reply reply = printProtocol(pos, container, drawMode);
+    console.endCapture();
+    surface->cells.trim();
+    return reply;
+}
+
+//------------------------------------------------------------------------------
+bool Box::sameBoundary(const Boundary& first, const Boundary& second) {
+    return first.left == second.left && first.top == second.top
+            && first.right == second.right && first.bottom == second.bottom;
+}
+
 //------------------------------------------------------------------------------
 //void Box::bufferBase(Position pos, Boundary container) {
 //    calculateActualDimAndPos(pos, container);
@@ -0,0 +1,136 @@
+//------------------------------------------------------------------------------
+// boxarena.cpp
+// Implementation for the BoxArena class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: A BoxArena is a region allocator for trees of Box objects. 
+//     Boxes allocated while a BoxArena is active on the current thread are
+//     placed contiguously within large memory blocks owned by the arena.
+//     Deleting an arena-allocated Box runs its destructor but does not free
+//     its memory; all blocks are released at once when the BoxArena is
+//     destroyed, and are reused once every allocated Box has been deleted.
+//     Boxes allocated from a BoxArena must not outlive it.
+//
+// Dependencies: None.
+//------------------------------------------------------------------------------
+
+#include "Box/boxarena.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+// Static member initialization
+thread_local BoxArena* BoxArena::activeArena = nullptr;
+std::map<const char*, BoxArena::Owner> BoxArena::blockOwners;
+std::mutex BoxArena::ownersLock;
+std::atomic<int> BoxArena::arenaCount{ 0 };
+
+//------------------------------------------------------------------------------
+BoxArena::Scope::Scope(BoxArena* arena) :
+    prevArena{ activeArena } {
+
+    activeArena = arena;
+}
+
+//------------------------------------------------------------------------------
+BoxArena::Scope::~Scope() {
+    activeArena = prevArena;
+}
+
+//------------------------------------------------------------------------------
+BoxArena::BoxArena(std::size_t blockSize) :
+    blocks{ },
+    blockSize{ blockSize },
+    currBlock{ 0 },
+    offset{ 0 },
+    liveCount{ 0 } {
+
+    ++arenaCount;
+}
+
+//------------------------------------------------------------------------------
+BoxArena::~BoxArena() {
+    std::lock_guard<std::mutex> lock(ownersLock);
+    for (const Block& block : blocks) {
+        blockOwners.erase(block.data.get());
+    }
+    --arenaCount;
+}
+
+//------------------------------------------------------------------------------
+void* BoxArena::allocate(std::size_t size) {
+    const std::size_t ALIGN = alignof(std::max_align_t);
+    size = (size + ALIGN - 1) / ALIGN * ALIGN;
+
+    // Nothing lives in the blocks anymore; start filling them again
+    if (liveCount == 0) {
+        currBlock = 0;
+        offset = 0;
+    }
+
+    // Advance to the next block that fits the allocation, adding a block if
+    // none of the remaining blocks fit
+    while (currBlock < blocks.size()
+            && offset + size > blocks[currBlock].size) {
+        ++currBlock;
+        offset = 0;
+    }
+    if (currBlock == blocks.size()) {
+        std::size_t newSize = size > blockSize ? size : blockSize;
+        blocks.push_back(Block{ std::unique_ptr<char[]>(new char[newSize]),
+                newSize });
+        offset = 0;
+
+        const char* start = blocks.back().data.get();
+        std::lock_guard<std::mutex> lock(ownersLock);
+        blockOwners[start] = Owner{ start + newSize, this };
+    }
+
+    void* region = blocks[currBlock].data.get() + offset;
+    offset += size;
+    ++liveCount;
+    return region;
+}
+
+//------------------------------------------------------------------------------
+void BoxArena::release() {
+    --liveCount;
+}
+
+//------------------------------------------------------------------------------
+int BoxArena::getLiveCount() const {
+    return liveCount;
+}
+
+//------------------------------------------------------------------------------
+std::size_t BoxArena::getReservedSize() const {
+    std::size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+//------------------------------------------------------------------------------
+BoxArena* BoxArena::getActive() {
+    return activeArena;
+}
+
+//------------------------------------------------------------------------------
+BoxArena* BoxArena::findOwner(const void* ptr) {
+    if (arenaCount == 0) {
+        return nullptr;
+    }
+
+    // The containing block is the last one that starts at or before ptr
+    const char* address = static_cast<const char*>(ptr);
+    std::lock_guard<std::mutex> lock(ownersLock);
+    auto it = blockOwners.upper_bound(address);
+    if (it == blockOwners.begin()) {
+        return nullptr;
+    }
+    --it;
+    return address < it->second.end ? it->second.arena : nullptr;
+}
+
+}
\ No newline at end of file
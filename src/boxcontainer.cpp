@@ -16,6 +16,15 @@
 
 namespace conu {
 
+//------------------------------------------------------------------------------
+// Static member initialization
+const unsigned BoxContainer::PARALLEL_MIN_ITEMS = 4;
+std::atomic<int> BoxContainer::culledCount{ 0 };
+std::atomic<int> BoxContainer::frameCulledCount{ 0 };
+std::atomic<int> BoxContainer::occludedCount{ 0 };
+std::atomic<int> BoxContainer::frameOccludedCount{ 0 };
+std::atomic<double> BoxContainer::frameOverdraw{ 0.0 };
+
 //------------------------------------------------------------------------------
 BoxContainer::BoxContainer() :
     Box(),
@@ -23,8 +32,19 @@ BoxContainer::BoxContainer() :
     distribution{ BoxDistrib::NONE },
     returnHeight{ 0 },
     returnWidth{ 0 },
-    dynamicSized{ false } {
-
+    dynamicSized{ false },
+    measureValid{ false },
+    measuredHeight{ 0 },
+    measuredWidth{ 0 },
+    arrangement{ },
+    arrangedBound{ 0, 0, -1, -1 },
+    arrangedOrigin{ -1, -1 },
+    arrangedPos{ -1, -1 },
+    arrangedWidth{ -1 },
+    arrangedHeight{ -1 },
+    arrangeValid{ false } {
+
+    opaqueBase = true;
 }
 
 //------------------------------------------------------------------------------
@@ -34,8 +54,82 @@ BoxContainer::BoxContainer(int width, int height) :
     distribution{ BoxDistrib::NONE },
     returnHeight{ 0 },
     returnWidth{ 0 },
-    dynamicSized{ false } {
+    dynamicSized{ false },
+    measureValid{ false },
+    measuredHeight{ 0 },
+    measuredWidth{ 0 },
+    arrangement{ },
+    arrangedBound{ 0, 0, -1, -1 },
+    arrangedOrigin{ -1, -1 },
+    arrangedPos{ -1, -1 },
+    arrangedWidth{ -1 },
+    arrangedHeight{ -1 },
+    arrangeValid{ false } {
+
+    opaqueBase = true;
+}
+
+//------------------------------------------------------------------------------
+BoxContainer::BoxContainer(const BoxContainer& copy) :
+    Box(copy),
+    recent{ nullptr },
+    distribution{ copy.distribution },
+    returnHeight{ copy.returnHeight },
+    returnWidth{ copy.returnWidth },
+    dynamicSized{ copy.dynamicSized },
+    measureValid{ false },
+    measuredHeight{ 0 },
+    measuredWidth{ 0 },
+    arrangement{ },
+    arrangedBound{ 0, 0, -1, -1 },
+    arrangedOrigin{ -1, -1 },
+    arrangedPos{ -1, -1 },
+    arrangedWidth{ -1 },
+    arrangedHeight{ -1 },
+    arrangeValid{ false } {
+
+    contents.reserve(copy.contents.size());
+    for (const BoxItem& content : copy.contents) {
+        BoxItem item = content;
+        item.item = content.item->copyBox();
+        contents.push_back(item);
+        adopt(item.item);
+
+        // Keep the most recent item pointing into this BoxContainer
+        if (content.item == copy.recent) {
+            recent = item.item;
+        }
+    }
+}
 
+//------------------------------------------------------------------------------
+BoxContainer::BoxContainer(BoxContainer&& move) :
+    Box(move),
+    contents{ std::move(move.contents) },
+    recent{ move.recent },
+    distribution{ move.distribution },
+    returnHeight{ move.returnHeight },
+    returnWidth{ move.returnWidth },
+    dynamicSized{ move.dynamicSized },
+    measureValid{ false },
+    measuredHeight{ 0 },
+    measuredWidth{ 0 },
+    arrangement{ },
+    arrangedBound{ 0, 0, -1, -1 },
+    arrangedOrigin{ -1, -1 },
+    arrangedPos{ -1, -1 },
+    arrangedWidth{ -1 },
+    arrangedHeight{ -1 },
+    arrangeValid{ false } {
+
+    for (const BoxItem& content : contents) {
+        content.item->parent = this;
+    }
+
+    move.contents.clear();
+    move.recent = nullptr;
+    move.arrangement.clear();
+    move.invalidateLayout();
 }
 
 //------------------------------------------------------------------------------
@@ -51,7 +145,8 @@ ItemAccessor BoxContainer::operator[] (int layer) {
 //------------------------------------------------------------------------------
 int BoxContainer::getHeight() const {
     if (dynamicSized) {
-        return std::max<int>(getContentHeight(), targetHeight);
+        measure();
+        return std::max<int>(measuredHeight, targetHeight);
     }
 
     return targetHeight;
@@ -60,7 +155,8 @@ int BoxContainer::getHeight() const {
 //------------------------------------------------------------------------------
 int BoxContainer::getWidth() const {
     if (dynamicSized) {
-        return std::max<int>(getContentWidth(), targetWidth);
+        measure();
+        return std::max<int>(measuredWidth, targetWidth);
     }
 
     return targetWidth;
@@ -68,57 +164,46 @@ int BoxContainer::getWidth() const {
 
 //------------------------------------------------------------------------------
 void BoxContainer::insert(const Box& inBox) {
-    int layer = 1;
-    for (layer; contents.find(layer) != contents.end(); ++layer);
-
     recent = inBox.copyBox();
-    contents[layer] = BoxItem{ recent, false, Position{-1, -1} };
+    placeItem(BoxItem{ nextFreeLayer(), recent, false, Position{-1, -1} });
 }
 
 //------------------------------------------------------------------------------
 void BoxContainer::insert(int layer, const Box& inBox) {
-    if (contents.find(layer) != contents.end()) {
-        delete contents[layer].item;
-        contents.erase(layer);
-    }
-
     recent = inBox.copyBox();
-    contents[layer] = BoxItem{ recent, false, Position{-1, -1} };
+    placeItem(BoxItem{ layer, recent, false, Position{-1, -1} });
 }
 
 //------------------------------------------------------------------------------
 void BoxContainer::insert(int layer, const Box& inBox, const Position& pos) {
-    if (contents.find(layer) != contents.end()) {
-        delete contents[layer].item;
-        contents.erase(layer);
-    }
-
     recent = inBox.copyBox();
-    contents[layer] = BoxItem{ recent, true, pos };
+    placeItem(BoxItem{ layer, recent, true, pos });
 }
 
 //------------------------------------------------------------------------------
 void BoxContainer::remove(int layer) {
-    auto it = contents.find(layer);
-    if (it == contents.end()) {
+    auto it = findLayer(layer);
+    if (it == contents.end() || it->layer != layer) {
         return;
     }
 
-    if (recent == it->second.item) {
+    if (recent == it->item) {
         recent = nullptr;
     }
-    delete it->second.item;
-    contents.erase(layer);
+    it->item->parent = nullptr;
+    delete it->item;
+    contents.erase(it);
+    invalidateLayout();
 }
 
 //------------------------------------------------------------------------------
 Box* BoxContainer::get(int layer) const {
-    auto target = contents.find(layer);
-    if (target == contents.end()) {
+    auto target = findLayer(layer);
+    if (target == contents.end() || target->layer != layer) {
         return nullptr;
     }
 
-    return target->second.item;
+    return target->item;
 }
 
 //------------------------------------------------------------------------------
@@ -129,11 +214,152 @@ Box* BoxContainer::getRecent() const {
 //------------------------------------------------------------------------------
 void BoxContainer::dynamicallySized(bool set) {
     dynamicSized = set;
+    invalidateLayout();
 }
 
 //------------------------------------------------------------------------------
 void BoxContainer::setDistribution(BoxDistrib distribution) {
     this->distribution = distribution;
+    arrangeValid = false;
+    invalidateSurface();
+}
+
+//------------------------------------------------------------------------------
+void BoxContainer::setAlignment(Align inAlign) {
+    Box::setAlignment(inAlign);
+    arrangeValid = false;
+}
+
+//------------------------------------------------------------------------------
+void BoxContainer::endFrame() {
+    frameCulledCount = culledCount.exchange(0);
+    frameOccludedCount = occludedCount.exchange(0);
+
+    Position winDim = console.getWindowDimensions();
+    double cellCount = static_cast<double>(winDim.col) * winDim.row;
+    unsigned long long writeCount = console.takeCellWriteCount();
+    frameOverdraw = cellCount > 0 ? writeCount / cellCount : 0.0;
+}
+
+//------------------------------------------------------------------------------
+int BoxContainer::getCulledCount() {
+    return frameCulledCount;
+}
+
+//------------------------------------------------------------------------------
+int BoxContainer::getOccludedCount() {
+    return frameOccludedCount;
+}
+
+//------------------------------------------------------------------------------
+double BoxContainer::getOverdraw() {
+    return frameOverdraw;
+}
+
+//------------------------------------------------------------------------------
+bool BoxContainer::discardMeasure() {
+    // The arrangement depends on the measured size of the contents
+    arrangeValid = false;
+
+    bool wasValid = measureValid;
+    measureValid = false;
+    return wasValid;
+}
+
+//------------------------------------------------------------------------------
+void BoxContainer::measure() const {
+    if (measureValid) {
+        return;
+    }
+
+    measuredHeight = getContentHeight();
+    measuredWidth = getContentWidth();
+    measureValid = true;
+}
+
+//------------------------------------------------------------------------------
+void BoxContainer::layout(const Position& pos) {
+    if (arrangeValid && pos.col == arrangedOrigin.col
+            && pos.row == arrangedOrigin.row
+            && absolutePos.col == arrangedPos.col
+            && absolutePos.row == arrangedPos.row
+            && actualWidth == arrangedWidth && actualHeight == arrangedHeight) {
+        return;
+    }
+
+    arrangement.clear();
+    arrangedBound = getContentBound(absolutePos);
+    arrangeContents(pos, arrangedBound);
+
+    arrangedOrigin = pos;
+    arrangedPos = absolutePos;
+    arrangedWidth = actualWidth;
+    arrangedHeight = actualHeight;
+    arrangeValid = true;
+}
+
+//------------------------------------------------------------------------------
+std::vector<BoxContainer::BoxItem>::iterator BoxContainer::findLayer(
+        int layer) {
+    return std::lower_bound(contents.begin(), contents.end(), layer,
+            [](const BoxItem& item, int layer) { return item.layer < layer; });
+}
+
+//------------------------------------------------------------------------------
+std::vector<BoxContainer::BoxItem>::const_iterator BoxContainer::findLayer(
+        int layer) const {
+    return std::lower_bound(contents.begin(), contents.end(), layer,
+            [](const BoxItem& item, int layer) { return item.layer < layer; });
+}
+
+//------------------------------------------------------------------------------
+int BoxContainer::nextFreeLayer() const {
+    // Layers from 1 upward are unique and increasing, so the amount of layers
+    // skipped before an item is non-decreasing along the contents
+    auto first = findLayer(1);
+    int count = static_cast<int>(contents.end() - first);
+    if (count == 0) {
+        return 1;
+    }
+
+    // Layers 1 to count are all taken; the first free layer follows the end
+    if (contents.back().layer == count) {
+        return count + 1;
+    }
+
+    // Search for the first item that follows a gap
+    auto gap = std::partition_point(first, contents.end(),
+            [&first](const BoxItem& item) {
+                return item.layer == static_cast<int>(&item - &*first) + 1;
+            });
+    return static_cast<int>(gap - first) + 1;
+}
+
+//------------------------------------------------------------------------------
+void BoxContainer::placeItem(const BoxItem& inItem) {
+    // Appending past the last layer is the common case
+    if (contents.empty() || contents.back().layer < inItem.layer) {
+        contents.push_back(inItem);
+    }
+    else {
+        auto it = findLayer(inItem.layer);
+        if (it != contents.end() && it->layer == inItem.layer) {
+            it->item->parent = nullptr;
+            delete it->item;
+            *it = inItem;
+        }
+        else {
+            contents.insert(it, inItem);
+        }
+    }
+
+    adopt(inItem.item);
+}
+
+//------------------------------------------------------------------------------
+void BoxContainer::adopt(Box* item) {
+    item->parent = this;
+    invalidateLayout();
 }
 
 //------------------------------------------------------------------------------
@@ -188,12 +414,176 @@ std::vector<int> BoxContainer::getSpacingHeight(const Boundary& container,
     return spacing;
 }
 
+//------------------------------------------------------------------------------
+void BoxContainer::printContents(bool drawMode) {
+    std::vector<ItemPlacement> visible;
+    std::vector<Boundary> visibleRects;
+    std::vector<char> coveredCells;
+    cullItems(arrangement, arrangedBound, visible, visibleRects, coveredCells);
+
+    paintBase(drawMode, &coveredCells);
+    printItems(visible, visibleRects, arrangedBound, drawMode);
+}
+
+//------------------------------------------------------------------------------
+void BoxContainer::cullItems(const std::vector<ItemPlacement>& placements,
+        const Boundary& contentBound, std::vector<ItemPlacement>& visible,
+        std::vector<Boundary>& visibleRects, std::vector<char>& coveredCells) {
+    Boundary visibleBound = clipToWindow(contentBound);
+    int boundWidth = visibleBound.right - visibleBound.left + 1;
+    int boundHeight = visibleBound.bottom - visibleBound.top + 1;
+    visible.clear();
+    visibleRects.clear();
+    coveredCells.assign(actualWidth > 0 && actualHeight > 0
+            ? actualWidth * actualHeight : 0, 0);
+    if (boundWidth <= 0 || boundHeight <= 0) {
+        for (const ItemPlacement& placement : placements) {
+            placement.item->skipPrint(placement.pos, contentBound);
+            ++culledCount;
+        }
+        return;
+    }
+
+    // Visit the Boxes from the last printed to the first, tracking the cells
+    // of the visible content boundary covered by opaque Boxes printed later
+    std::vector<char> coverage(boundWidth * boundHeight, 0);
+    visible.reserve(placements.size());
+    visibleRects.reserve(placements.size());
+    for (auto it = placements.rbegin(); it != placements.rend(); ++it) {
+        // Boxes that are clipped to an empty rect are culled without printing
+        Position fitPos;
+        int fitWidth;
+        int fitHeight;
+        fitToContainer(it->pos, visibleBound, it->item->getWidth(),
+                it->item->getHeight(), fitPos, fitWidth, fitHeight);
+        if (fitWidth <= 0 || fitHeight <= 0) {
+            it->item->skipPrint(it->pos, contentBound);
+            ++culledCount;
+            continue;
+        }
+
+        // Boxes that are fully covered are occluded without printing
+        int startCol = fitPos.col - visibleBound.left;
+        int startRow = fitPos.row - visibleBound.top;
+        bool hidden = true;
+        for (int row = startRow; row < startRow + fitHeight && hidden; ++row) {
+            const char* cell = &coverage[row * boundWidth + startCol];
+            hidden = std::find(cell, cell + fitWidth, 0) == cell + fitWidth;
+        }
+        if (hidden) {
+            it->item->skipPrint(it->pos, contentBound);
+            ++occludedCount;
+            continue;
+        }
+
+        if (it->item->opaqueBase && !it->item->transparent) {
+            for (int row = startRow; row < startRow + fitHeight; ++row) {
+                char* cell = &coverage[row * boundWidth + startCol];
+                std::fill(cell, cell + fitWidth, 1);
+            }
+        }
+
+        visible.push_back(*it);
+        visibleRects.push_back(Boundary{ fitPos.col, fitPos.row,
+                fitPos.col + fitWidth - 1, fitPos.row + fitHeight - 1 });
+    }
+    std::reverse(visible.begin(), visible.end());
+    std::reverse(visibleRects.begin(), visibleRects.end());
+
+    // Flag the cells of the base that are covered within the visible content
+    // boundary
+    int baseCol = visibleBound.left - absolutePos.col;
+    for (int row = 0; row < boundHeight; ++row) {
+        int baseRow = visibleBound.top + row - absolutePos.row;
+        if (baseRow < 0 || baseRow >= actualHeight || baseCol < 0
+                || baseCol + boundWidth > actualWidth) {
+            continue;
+        }
+
+        const char* cell = &coverage[row * boundWidth];
+        std::copy(cell, cell + boundWidth,
+                coveredCells.begin() + baseRow * actualWidth + baseCol);
+    }
+}
+
+//------------------------------------------------------------------------------
+void BoxContainer::printItems(const std::vector<ItemPlacement>& visible,
+        const std::vector<Boundary>& visibleRects,
+        const Boundary& contentBound, bool drawMode) {
+    // Workers can only write to the buffer on behalf of a thread holding it.
+    // Drawing is always serial since it moves the shared console cursor, and
+    // captures of retained surfaces only record writes of their own thread.
+    RenderPool& pool = RenderPool::getInstance();
+    if (drawMode || pool.getThreadCount() <= 1 || RenderPool::onWorkerThread()
+            || !console.ownsWriteBuffer() || console.capturing()
+            || visible.size() < PARALLEL_MIN_ITEMS) {
+        for (const ItemPlacement& placement : visible) {
+            if (drawMode) {
+                placement.item->draw(placement.pos, contentBound);
+            }
+            else {
+                placement.item->buffer(placement.pos, contentBound);
+            }
+        }
+        return;
+    }
+
+    // Split the Boxes into runs of consecutive Boxes that do not overlap. Each
+    // run is buffered in parallel, and runs are buffered in list order so that
+    // overlapping Boxes keep their layering.
+    std::vector<Boundary> runRects;
+    std::vector<std::function<void()>> runJobs;
+    for (std::size_t i = 0; i < visible.size(); ++i) {
+        const Boundary& rect = visibleRects[i];
+        for (const Boundary& runRect : runRects) {
+            if (rectsOverlap(rect, runRect)) {
+                pool.run(runJobs);
+                runJobs.clear();
+                runRects.clear();
+                break;
+            }
+        }
+
+        Box* item = visible[i].item;
+        Position pos = visible[i].pos;
+        runRects.push_back(rect);
+        runJobs.push_back([item, pos, contentBound]() {
+                bool borrowed = !console.ownsWriteBuffer();
+                if (borrowed) {
+                    console.borrowWriteBuffer();
+                }
+                item->buffer(pos, contentBound);
+                if (borrowed) {
+                    console.returnWriteBuffer();
+                }
+            });
+    }
+    pool.run(runJobs);
+}
+
+//------------------------------------------------------------------------------
+bool BoxContainer::rectsOverlap(const Boundary& first,
+        const Boundary& second) {
+    // Empty rectangles do not cover any cells
+    if (first.right < first.left || first.bottom < first.top
+            || second.right < second.left || second.bottom < second.top) {
+        return false;
+    }
+
+    return first.left <= second.right && second.left <= first.right
+            && first.top <= second.bottom && second.top <= first.bottom;
+}
+
 //------------------------------------------------------------------------------
 void BoxContainer::clearContents() {
-    while (!contents.empty()) {
-        delete contents.begin()->second.item;
-        contents.erase(contents.begin()->first);
+    for (BoxItem& content : contents) {
+        content.item->parent = nullptr;
+        delete content.item;
     }
+    contents.clear();
+    measureValid = false;
+    arrangement.clear();
+    arrangeValid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,61 @@
+//------------------------------------------------------------------------------
+// boxregistry.cpp
+// Implementation for the BoxRegistry class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: The BoxRegistry keeps an index of live Box objects by their
+//     unique identifier. A BoxHandle is a typed reference to a Box that is
+//     checked against the BoxRegistry on every access, so a handle to a Box
+//     that has been removed, replaced, or destroyed safely resolves to
+//     nullptr instead of dangling. Only Boxes that a BoxHandle has been made
+//     for are indexed. Access to the BoxRegistry is thread safe.
+//     The BoxRegistry class is a singleton and can be accessed through the
+//     BoxRegistry::getInstance() method.
+// 
+// Dependencies: Box class.
+//------------------------------------------------------------------------------
+
+#include "Box/boxregistry.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+BoxRegistry::BoxRegistry() :
+    indexLock{ },
+    liveBoxes{ } {
+
+}
+
+//------------------------------------------------------------------------------
+BoxRegistry& BoxRegistry::getInstance() {
+    // Never destroyed, since static Boxes may unindex themselves during
+    // static destruction
+    static BoxRegistry* instance = new BoxRegistry();
+    return *instance;
+}
+
+//------------------------------------------------------------------------------
+void BoxRegistry::index(Box& box) {
+    std::lock_guard<std::mutex> lock(indexLock);
+    liveBoxes[box.boxId] = &box;
+    box.indexed = true;
+}
+
+//------------------------------------------------------------------------------
+Box* BoxRegistry::find(unsigned id) const {
+    std::lock_guard<std::mutex> lock(indexLock);
+    auto it = liveBoxes.find(id);
+    if (it == liveBoxes.end()) {
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+//------------------------------------------------------------------------------
+void BoxRegistry::unindex(unsigned id) {
+    std::lock_guard<std::mutex> lock(indexLock);
+    liveBoxes.erase(id);
+}
+
+}
\ No newline at end of file
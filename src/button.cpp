@@ -17,7 +17,6 @@ namespace conu {
 Button::Button(std::string text) :
     TextBox(text),
     clickHandler{ nullptr },
-    inputClickHandler{ nullptr }, 
     passInput{ false } {
 
 }
@@ -26,7 +25,6 @@ Button::Button(std::string text) :
 Button::Button(int width, int height, std::string text) :
     TextBox(width, height, text),
     clickHandler{ nullptr },
-    inputClickHandler{ nullptr },
     passInput{ false } {
 
 }
@@ -37,10 +35,7 @@ Reply Button::interact(inputEvent::MouseEvent action) {
     if (!drawn) {
         return Reply::FAILED;
     }
-    if (!passInput && clickHandler == nullptr) {
-        return Reply::FAILED;
-    }
-    if (passInput && inputClickHandler == nullptr) {
+    if (clickHandler == nullptr) {
         return Reply::FAILED;
     }
 
@@ -56,10 +51,7 @@ Reply Button::interact(inputEvent::MouseEvent action) {
     }
 
     // Execute click handler and return reply
-    if (passInput) {
-        return inputClickHandler(*this, action);
-    }
-    return clickHandler(*this);
+    return clickHandler(*this, action);
 }
 
 //--------------------------------------------------------------------------
@@ -79,14 +71,21 @@ std::string Button::getClassName() const {
 
 //--------------------------------------------------------------------------
 void Button::setAction(std::function<Reply(Button&)> action) {
-    clickHandler = action;
     passInput = false;
+    if (action == nullptr) {
+        clickHandler = nullptr;
+        return;
+    }
+
+    clickHandler = [action](Button& button, inputEvent::MouseEvent) {
+        return action(button);
+    };
 }
 
 //--------------------------------------------------------------------------
 void Button::setAction(std::function<Reply(Button&, 
         inputEvent::MouseEvent)> action) {
-    inputClickHandler = action;
+    clickHandler = action;
     passInput = true;
 }
 
@@ -0,0 +1,151 @@
+//------------------------------------------------------------------------------
+// cellsurface.cpp
+// Implementation for the CellSurface class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: A CellSurface is a rectangular grid of console cells that
+//     retains the characters written within its boundary. Only cells that
+//     were written to are part of the surface, so a surface that is printed
+//     again leaves every other cell untouched. Cells are recorded through
+//     ConsoleEditor::beginCapture() and printed back as horizontal spans of
+//     written cells.
+//
+// Dependencies: InputEvent struct.
+//------------------------------------------------------------------------------
+
+#include "ConsoleEditor/cellsurface.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+CellSurface::CellSurface() :
+    clip{ 0, 0, -1, -1 },
+    origin{ 0, 0 },
+    width{ 0 },
+    height{ 0 } {
+
+}
+
+//------------------------------------------------------------------------------
+void CellSurface::reset(const Boundary& clip) {
+    this->clip = clip;
+    origin = Position{ clip.left, clip.top };
+    width = clip.right - clip.left + 1;
+    height = clip.bottom - clip.top + 1;
+    if (width <= 0 || height <= 0) {
+        width = 0;
+        height = 0;
+    }
+
+    cells.assign(width * height, ' ');
+    written.assign(width * height, 0);
+}
+
+//------------------------------------------------------------------------------
+void CellSurface::record(const Position& pos, const char text[], int length) {
+    int row = pos.row - origin.row;
+    if (row < 0 || row >= height) {
+        return;
+    }
+
+    int startCol = pos.col - origin.col;
+    int endCol = startCol + length;
+    int textIdx = 0;
+    if (startCol < 0) {
+        textIdx = -startCol;
+        startCol = 0;
+    }
+    if (endCol > width) {
+        endCol = width;
+    }
+    if (startCol >= endCol) {
+        return;
+    }
+
+    int cellIdx = row * width + startCol;
+    std::copy(text + textIdx, text + textIdx + (endCol - startCol),
+            cells.begin() + cellIdx);
+    std::fill(written.begin() + cellIdx, written.begin() + cellIdx
+            + (endCol - startCol), 1);
+}
+
+//------------------------------------------------------------------------------
+void CellSurface::trim() {
+    // Find the bounding rectangle of the written cells
+    int left = width;
+    int top = height;
+    int right = -1;
+    int bottom = -1;
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width; ++col) {
+            if (!written[row * width + col]) {
+                continue;
+            }
+            left = col < left ? col : left;
+            right = col > right ? col : right;
+            top = row < top ? row : top;
+            bottom = row;
+        }
+    }
+
+    if (right < 0) {
+        width = 0;
+        height = 0;
+        cells.clear();
+        written.clear();
+        return;
+    }
+
+    int trimWidth = right - left + 1;
+    int trimHeight = bottom - top + 1;
+    if (trimWidth == width && trimHeight == height) {
+        return;
+    }
+
+    std::vector<char> trimCells(trimWidth * trimHeight);
+    std::vector<char> trimWritten(trimWidth * trimHeight);
+    for (int row = 0; row < trimHeight; ++row) {
+        int srcIdx = (top + row) * width + left;
+        std::copy(cells.begin() + srcIdx, cells.begin() + srcIdx + trimWidth,
+                trimCells.begin() + row * trimWidth);
+        std::copy(written.begin() + srcIdx,
+                written.begin() + srcIdx + trimWidth,
+                trimWritten.begin() + row * trimWidth);
+    }
+
+    origin = Position{ origin.col + left, origin.row + top };
+    width = trimWidth;
+    height = trimHeight;
+    cells.swap(trimCells);
+    written.swap(trimWritten);
+}
+
+//------------------------------------------------------------------------------
+const Boundary& CellSurface::getClip() const {
+    return clip;
+}
+
+//------------------------------------------------------------------------------
+void CellSurface::forEachSpan(const std::function<void(const Position&,
+        const char[], int)>& print) const {
+    for (int row = 0; row < height; ++row) {
+        int col = 0;
+        while (col < width) {
+            // Skip cells that were not written to
+            while (col < width && !written[row * width + col]) {
+                ++col;
+            }
+
+            int startCol = col;
+            while (col < width && written[row * width + col]) {
+                ++col;
+            }
+            if (col > startCol) {
+                print(Position{ origin.col + startCol, origin.row + row },
+                        &cells[row * width + startCol], col - startCol);
+            }
+        }
+    }
+}
+
+}
\ No newline at end of file
@@ -21,6 +21,10 @@ const HANDLE ConsoleEditor::IN_HANDLE = GetStdHandle(STD_INPUT_HANDLE);
 const HWND ConsoleEditor::WINDOW_HANDLE = GetConsoleWindow();
 
 ConsoleEditor ConsoleEditor::consoleInstance;
+thread_local bool ConsoleEditor::writeBufferOwner = false;
+thread_local int ConsoleEditor::cellWriter = OverdrawMap::NO_WRITER;
+thread_local std::vector<CellSurface*> ConsoleEditor::captures;
+thread_local std::vector<DisplayList*> ConsoleEditor::recordings;
 
 //------------------------------------------------------------------------------
 ConsoleEditor::ConsoleEditor() :
@@ -29,7 +33,16 @@ ConsoleEditor::ConsoleEditor() :
     resizeManagerThread{ },
     resizeHandler{ []() { return; } },
     terminateResizeManager{ false },
-    resizeManagerActive{ false } {
+    resizeManagerActive{ false },
+    presenterThread{ },
+    terminatePresenter{ false },
+    presenterActive{ false },
+    framePending{ false },
+    framePresenting{ false },
+    watchCount{ 0 },
+    nextWatchId{ 1 },
+    cellWriteCount{ 0 },
+    trackingOverdraw{ false } {
 
     formatWriteBuffer();
 }
@@ -37,6 +50,7 @@ ConsoleEditor::ConsoleEditor() :
 //------------------------------------------------------------------------------
 ConsoleEditor::~ConsoleEditor() {
     stopResizeManager();
+    stopPresenter();
 }
 
 //------------------------------------------------------------------------------
@@ -108,8 +122,45 @@ bool ConsoleEditor::resizeManagerRunning() const {
     return resizeManagerActive;
 }
 
+//------------------------------------------------------------------------------
+void ConsoleEditor::startPresenter() {
+    std::lock_guard<std::mutex> controlLock(presenterControlLock);
+    std::lock_guard<std::mutex> lock(presentLock);
+    if (presenterActive) {
+        return;
+    }
+
+    terminatePresenter = false;
+    presenterActive = true;
+    presenterThread = std::thread(&ConsoleEditor::presenter, this);
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::stopPresenter() {
+    std::lock_guard<std::mutex> controlLock(presenterControlLock);
+    std::unique_lock<std::mutex> lock(presentLock);
+    if (!presenterActive) {
+        return;
+    }
+
+    // Frames presented from here on are printed directly by the caller
+    terminatePresenter = true;
+    presenterActive = false;
+    lock.unlock();
+    presentCV.notify_all();
+    presenterThread.join();
+}
+
+//------------------------------------------------------------------------------
+bool ConsoleEditor::presenterRunning() const {
+    return presenterActive;
+}
+
 //------------------------------------------------------------------------------
 bool ConsoleEditor::setWindowDimensions(short width, short height) {
+    // Do not resize the window underneath a frame that is being printed
+    waitForPresenter();
+
     // height needs to be incremented to prevent flickering effect on release
     // builds of CONU programs. The window screen seems to be slightly smaller
     // than that provided height, so any output to the bottom row causes all
@@ -231,6 +282,36 @@ InputEvent ConsoleEditor::getButtonInput() {
     return InputEvent(inBuff[0]);
 }
 
+//------------------------------------------------------------------------------
+bool ConsoleEditor::inputPending() const {
+    DWORD eventCount = 0;
+    if (!GetNumberOfConsoleInputEvents(IN_HANDLE, &eventCount)) {
+        return false;
+    }
+
+    return eventCount > 0;
+}
+
+//------------------------------------------------------------------------------
+bool ConsoleEditor::buttonInputPending() {
+    INPUT_RECORD inBuff[1];
+    DWORD eventCount = 0;
+    while (PeekConsoleInput(IN_HANDLE, inBuff, 1, &eventCount)
+            && eventCount > 0) {
+        if (inBuff[0].EventType != MOUSE_EVENT
+                || inBuff[0].Event.MouseEvent.dwEventFlags != MOUSE_MOVED) {
+            return true;
+        }
+
+        // Discard the movement since getButtonInput() ignores it anyway
+        if (readInputBuffer(inBuff, 1) == -1) {
+            return false;
+        }
+    }
+
+    return false;
+}
+
 //------------------------------------------------------------------------------
 InputEvent ConsoleEditor::getRawInput() {
     INPUT_RECORD inBuff[1];
@@ -331,26 +412,47 @@ bool ConsoleEditor::setFontSize(int size) {
 
 //------------------------------------------------------------------------------
 void ConsoleEditor::writeToScreen(const Position& pos, const char text[]) {
+    int length = 0;
+    for (length = 0; text[length]; ++length);
+
+    writeToScreen(pos, text, length);
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::writeToScreen(const Position& pos, const char text[],
+        int length) {
+    waitForPresenter();
+
     Position prevPos = getCursorPosition();
     LPDWORD charsWritten = 0;
-    DWORD charsToWrite = 0;
-
-    for (charsToWrite = 0; text[charsToWrite]; ++charsToWrite);
+    DWORD charsToWrite = length < 0 ? 0 : static_cast<DWORD>(length);
 
     setCursorPosition(pos);
     WriteConsoleA(OUT_HANDLE, text, charsToWrite, charsWritten, NULL);
     setCursorPosition(prevPos);
+    recordShown(pos, text, static_cast<int>(charsToWrite));
+    recordWrite(pos, text, static_cast<int>(charsToWrite));
 }
 
 //------------------------------------------------------------------------------
 void ConsoleEditor::writeToBuffer(const Position& pos, const char text[]) {
-    std::lock_guard<std::mutex> lock(writeBufferLock);
+    int length = 0;
+    for (length = 0; text[length]; ++length);
+
+    writeToBuffer(pos, text, length);
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::writeToBuffer(const Position& pos, const char text[],
+        int length) {
+    std::unique_lock<std::mutex> lock(writeBufferLock, std::defer_lock);
+    if (!writeBufferOwner) {
+        lock.lock();
+    }
 
-    int textIdx = 0;
     if (writeBuffer.size() == 0) {
         return;
     }
-    Position drawIdx = { pos.col, pos.row };
     Position buffDim{ (int)writeBuffer[0].size() - 1, 
             (int)writeBuffer.size() - 1 };
 
@@ -362,28 +464,303 @@ void ConsoleEditor::writeToBuffer(const Position& pos, const char text[]) {
         return;
     }
 
-    // Write to write buffer
-    while (text[textIdx] && pos.col + textIdx 
-            < (int)writeBuffer[pos.row].size()) {
-        writeBuffer[pos.row][drawIdx.col++] = text[textIdx++];
+    // Copy the span of text that fits within the write buffer row
+    int fitLength = (int)writeBuffer[pos.row].size() - pos.col;
+    if (length < fitLength) {
+        fitLength = length;
     }
+    if (fitLength > 0) {
+        std::copy(text, text + fitLength, &writeBuffer[pos.row][pos.col]);
+        recordWrite(pos, text, fitLength);
+        disturbWatches(Boundary{ pos.col, pos.row, pos.col + fitLength - 1,
+                pos.row });
+    }
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::writeEdgesToScreen(const Position& pos, const char text[],
+        int length, int edgeLength) {
+    if (edgeLength * 2 >= length) {
+        writeToScreen(pos, text, length);
+        return;
+    }
+    if (edgeLength <= 0) {
+        return;
+    }
+
+    writeToScreen(pos, text, edgeLength);
+    writeToScreen(Position{ pos.col + length - edgeLength, pos.row },
+            text + length - edgeLength, edgeLength);
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::writeEdgesToBuffer(const Position& pos, const char text[],
+        int length, int edgeLength) {
+    if (edgeLength * 2 >= length) {
+        writeToBuffer(pos, text, length);
+        return;
+    }
+    if (edgeLength <= 0) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(writeBufferLock, std::defer_lock);
+    if (!writeBufferOwner) {
+        lock.lock();
+    }
+
+    if (writeBuffer.size() == 0) {
+        return;
+    }
+    if (pos.row < 0 || pos.row > (int)writeBuffer.size() - 1) {
+        return;
+    }
+
+    // Clip both edges to the write buffer row
+    std::vector<char>& row = writeBuffer[pos.row];
+    int rowSize = (int)row.size();
+    int edgeStarts[2] = { pos.col, pos.col + length - edgeLength };
+    for (int edge = 0; edge < 2; ++edge) {
+        int textIdx = edge == 0 ? 0 : length - edgeLength;
+        int startCol = edgeStarts[edge];
+        int endCol = startCol + edgeLength;
+        if (startCol < 0) {
+            textIdx -= startCol;
+            startCol = 0;
+        }
+        if (endCol > rowSize) {
+            endCol = rowSize;
+        }
+        if (startCol < endCol) {
+            std::copy(text + textIdx, text + textIdx + (endCol - startCol),
+                    &row[startCol]);
+            recordWrite(Position{ startCol, pos.row }, text + textIdx,
+                    endCol - startCol);
+            disturbWatches(Boundary{ startCol, pos.row, endCol - 1,
+                    pos.row });
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+int ConsoleEditor::watchBufferRegion(int watchId, const Boundary& rect) {
+    std::lock_guard<std::mutex> lock(watchLock);
+    for (RegionWatch& watch : regionWatches) {
+        if (watch.id == watchId) {
+            watch.rect = rect;
+            watch.disturbed = false;
+            return watchId;
+        }
+    }
+
+    regionWatches.push_back(RegionWatch{ nextWatchId, rect, false });
+    ++watchCount;
+    return nextWatchId++;
+}
+
+//------------------------------------------------------------------------------
+bool ConsoleEditor::bufferRegionDisturbed(int watchId) const {
+    std::lock_guard<std::mutex> lock(watchLock);
+    for (const RegionWatch& watch : regionWatches) {
+        if (watch.id == watchId) {
+            return watch.disturbed;
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::unwatchBufferRegion(int watchId) {
+    std::lock_guard<std::mutex> lock(watchLock);
+    for (auto it = regionWatches.begin(); it != regionWatches.end(); ++it) {
+        if (it->id == watchId) {
+            regionWatches.erase(it);
+            --watchCount;
+            return;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+unsigned long long ConsoleEditor::takeCellWriteCount() {
+    return cellWriteCount.exchange(0);
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::setOverdrawTracking(bool tracking) {
+    if (tracking && !trackingOverdraw) {
+        resetOverdraw();
+    }
+    trackingOverdraw = tracking;
+}
+
+//------------------------------------------------------------------------------
+bool ConsoleEditor::overdrawTracking() const {
+    return trackingOverdraw;
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::resetOverdraw() {
+    std::unique_lock<std::mutex> lock(writeBufferLock, std::defer_lock);
+    if (!writeBufferOwner) {
+        lock.lock();
+    }
+
+    int rows = writeBuffer.size();
+    int cols = rows > 0 ? writeBuffer[0].size() : 0;
+    std::lock_guard<std::mutex> overdrawGuard(overdrawLock);
+    overdrawMap.reset(cols, rows);
+}
+
+//------------------------------------------------------------------------------
+int ConsoleEditor::setCellWriter(const std::string& name) {
+    int prevWriter = cellWriter;
+    std::lock_guard<std::mutex> lock(overdrawLock);
+    cellWriter = overdrawMap.internWriter(name);
+    return prevWriter;
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::restoreCellWriter(int writer) {
+    cellWriter = writer;
+}
+
+//------------------------------------------------------------------------------
+OverdrawMap ConsoleEditor::getOverdraw() const {
+    std::lock_guard<std::mutex> lock(overdrawLock);
+    return overdrawMap;
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::printOverdraw(bool drawMode) {
+    OverdrawMap heatmap = getOverdraw();
+    if (drawMode) {
+        waitForPresenter();
+
+        Position prevPos = getCursorPosition();
+        for (int row = 0; row < heatmap.getHeight(); ++row) {
+            std::string heatRow = heatmap.getHeatRow(row);
+            LPDWORD charsWritten = 0;
+            setCursorPosition(Position{ 0, row });
+            WriteConsoleA(OUT_HANDLE, heatRow.data(),
+                    static_cast<DWORD>(heatRow.size()), charsWritten, NULL);
+            recordShown(Position{ 0, row }, heatRow.data(),
+                    static_cast<int>(heatRow.size()));
+        }
+        setCursorPosition(prevPos);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(writeBufferLock, std::defer_lock);
+    if (!writeBufferOwner) {
+        lock.lock();
+    }
+
+    // The write buffer may have been resized since the map was reset
+    for (int row = 0; row < heatmap.getHeight()
+            && row < (int)writeBuffer.size(); ++row) {
+        std::string heatRow = heatmap.getHeatRow(row);
+        std::size_t fitLength = std::min(heatRow.size(),
+                writeBuffer[row].size());
+        std::copy(heatRow.begin(), heatRow.begin() + fitLength,
+                writeBuffer[row].begin());
+        disturbWatches(Boundary{ 0, row, (int)fitLength - 1, row });
+    }
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::beginCapture(CellSurface& surface) {
+    captures.push_back(&surface);
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::endCapture() {
+    if (!captures.empty()) {
+        captures.pop_back();
+    }
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::beginRecording(DisplayList& list) {
+    recordings.push_back(&list);
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::endRecording() {
+    if (!recordings.empty()) {
+        recordings.pop_back();
+    }
+}
+
+//------------------------------------------------------------------------------
+bool ConsoleEditor::capturing() const {
+    return !captures.empty() || !recordings.empty();
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::lockWriteBuffer() {
+    writeBufferLock.lock();
+    writeBufferOwner = true;
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::unlockWriteBuffer() {
+    writeBufferOwner = false;
+    writeBufferLock.unlock();
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::borrowWriteBuffer() {
+    writeBufferOwner = true;
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::returnWriteBuffer() {
+    writeBufferOwner = false;
+}
+
+//------------------------------------------------------------------------------
+bool ConsoleEditor::ownsWriteBuffer() const {
+    return writeBufferOwner;
 }
 
 //------------------------------------------------------------------------------
 void ConsoleEditor::printWriteBuffer() {
-    std::lock_guard<std::mutex> lock(writeBufferLock);
+    waitForPresenter();
 
-    Position prevPos = getCursorPosition();
-    Position writePos = { 0, 0 };
-    LPDWORD charsWritten = 0;
+    std::lock_guard<std::mutex> lock(writeBufferLock);
+    writeFrame(writeBuffer);
+}
 
-    for (writePos.row; writePos.row < (int)writeBuffer.size(); ++writePos.row) {
-        setCursorPosition(writePos);
-        WriteConsoleA(OUT_HANDLE, &writeBuffer[writePos.row][0], 
-                writeBuffer[writePos.row].size(), charsWritten, NULL);
+//------------------------------------------------------------------------------
+void ConsoleEditor::presentWriteBuffer() {
+    std::unique_lock<std::mutex> lock(presentLock);
+    if (!presenterActive) {
+        lock.unlock();
+        printWriteBuffer();
+        return;
     }
 
-    setCursorPosition(prevPos);
+    // Bounded hand-off: wait for the present thread to pick up the previous
+    // frame before replacing it
+    presentCV.wait(lock, [this]() { return !framePending; });
+
+    std::unique_lock<std::mutex> bufferLock(writeBufferLock);
+    pendingFrame = writeBuffer;
+    bufferLock.unlock();
+
+    framePending = true;
+    lock.unlock();
+    presentCV.notify_all();
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::waitForPresenter() {
+    std::unique_lock<std::mutex> lock(presentLock);
+    presentCV.wait(lock, [this]() {
+            return !framePending && !framePresenting;
+        });
 }
 
 //------------------------------------------------------------------------------
@@ -392,6 +769,8 @@ void ConsoleEditor::printWriteBuffer() {
 // https://stackoverflow.com/questions/5866529/how-do-we-clear-the-console-in-
 //     assembly/5866648#5866648
 void ConsoleEditor::clearScreen() {
+    waitForPresenter();
+
     COORD tl = { 0, 0 };
     CONSOLE_SCREEN_BUFFER_INFO s;
     GetConsoleScreenBufferInfo(OUT_HANDLE, &s);
@@ -399,11 +778,21 @@ void ConsoleEditor::clearScreen() {
     FillConsoleOutputCharacter(OUT_HANDLE, ' ', cells, tl, &written);
     FillConsoleOutputAttribute(OUT_HANDLE, s.wAttributes, cells, tl, &written);
     SetConsoleCursorPosition(OUT_HANDLE, tl);
+    invalidateShownFrame();
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::invalidateShownFrame() {
+    std::lock_guard<std::mutex> lock(shownFrameLock);
+    shownFrame.clear();
 }
 
 //------------------------------------------------------------------------------
 void ConsoleEditor::clearWriteBuffer() {
-    std::lock_guard<std::mutex> lock(writeBufferLock);
+    std::unique_lock<std::mutex> lock(writeBufferLock, std::defer_lock);
+    if (!writeBufferOwner) {
+        lock.lock();
+    }
 
     int rows = writeBuffer.size();
     int cols = writeBuffer[0].size();
@@ -412,6 +801,7 @@ void ConsoleEditor::clearWriteBuffer() {
             writeBuffer[i][j] = ' ';
         }
     }
+    disturbWatches(Boundary{ 0, 0, cols - 1, rows - 1 });
 }
 
 //------------------------------------------------------------------------------
@@ -429,6 +819,9 @@ void ConsoleEditor::formatWriteBuffer() {
 
     lock.unlock();
     clearWriteBuffer();
+
+    // The console window contents may have moved with the new dimensions
+    invalidateShownFrame();
 }
 
 //------------------------------------------------------------------------------
@@ -495,4 +888,122 @@ void ConsoleEditor::resizeManager() {
     }
 }
 
+//------------------------------------------------------------------------------
+void ConsoleEditor::presenter() {
+    std::unique_lock<std::mutex> lock(presentLock);
+
+    while (true) {
+        presentCV.wait(lock, [this]() {
+                return framePending || terminatePresenter;
+            });
+
+        // Print any remaining frame before terminating
+        if (!framePending) {
+            return;
+        }
+
+        std::swap(presentFrame, pendingFrame);
+        framePending = false;
+        framePresenting = true;
+        lock.unlock();
+        presentCV.notify_all();
+
+        writeFrame(presentFrame);
+
+        lock.lock();
+        framePresenting = false;
+        presentCV.notify_all();
+    }
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::recordWrite(const Position& pos, const char text[],
+        int length) {
+    cellWriteCount.fetch_add(length, std::memory_order_relaxed);
+
+    if (trackingOverdraw) {
+        std::lock_guard<std::mutex> lock(overdrawLock);
+        overdrawMap.record(pos, length, cellWriter);
+    }
+
+    for (CellSurface* surface : captures) {
+        surface->record(pos, text, length);
+    }
+    for (DisplayList* list : recordings) {
+        list->addSpan(pos, text, length);
+    }
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::disturbWatches(const Boundary& rect) {
+    // Most frames are printed without any watch
+    if (watchCount == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(watchLock);
+    for (RegionWatch& watch : regionWatches) {
+        if (watch.rect.left <= rect.right && watch.rect.right >= rect.left
+                && watch.rect.top <= rect.bottom
+                && watch.rect.bottom >= rect.top) {
+            watch.disturbed = true;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::recordShown(const Position& pos, const char text[],
+        int length) {
+    std::lock_guard<std::mutex> lock(shownFrameLock);
+    if (pos.row < 0 || pos.row > (int)shownFrame.size() - 1) {
+        return;
+    }
+
+    std::vector<char>& row = shownFrame[pos.row];
+    int startCol = std::max(pos.col, 0);
+    int endCol = std::min(pos.col + length, (int)row.size());
+    if (startCol < endCol) {
+        std::copy(text + (startCol - pos.col), text + (endCol - pos.col),
+                row.begin() + startCol);
+    }
+}
+
+//------------------------------------------------------------------------------
+void ConsoleEditor::writeFrame(const std::vector<std::vector<char>>& frame) {
+    std::lock_guard<std::mutex> lock(shownFrameLock);
+    Position prevPos = getCursorPosition();
+    LPDWORD charsWritten = 0;
+
+    // Rows that were never shown are written in full
+    shownFrame.resize(frame.size());
+    for (int row = 0; row < (int)frame.size(); ++row) {
+        const std::vector<char>& frameRow = frame[row];
+        std::vector<char>& shownRow = shownFrame[row];
+        int first = 0;
+        int last = (int)frameRow.size() - 1;
+        if (shownRow.size() == frameRow.size()) {
+            while (first <= last && frameRow[first] == shownRow[first]) {
+                ++first;
+            }
+            while (last >= first && frameRow[last] == shownRow[last]) {
+                --last;
+            }
+        }
+        else {
+            shownRow.resize(frameRow.size());
+        }
+        if (first > last) {
+            continue;
+        }
+
+        setCursorPosition(Position{ first, row });
+        WriteConsoleA(OUT_HANDLE, &frameRow[first], last - first + 1,
+                charsWritten, NULL);
+        std::copy(frameRow.begin() + first, frameRow.begin() + last + 1,
+                shownRow.begin() + first);
+    }
+
+    setCursorPosition(prevPos);
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,252 @@
+//------------------------------------------------------------------------------
+// displaylist.cpp
+// Implementation for the DisplayList class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: A DisplayList is a flat list of draw commands that reproduces
+//     the cells written while printing a Box tree. Writes are recorded through
+//     ConsoleEditor::beginRecording() as fill commands, which cover a rectangle
+//     with a single character, and span commands, which copy a run of text to
+//     a single row. Fills of consecutive rows are merged into a single
+//     rectangle, so backgrounds and borders take a few commands each. A
+//     DisplayList can be replayed to the console screen, the write buffer, a
+//     CellSurface, or a frame of character rows, and can be saved to and
+//     loaded from a binary stream.
+//
+// Dependencies: InputEvent struct and CellSurface class.
+//------------------------------------------------------------------------------
+
+#include "ConsoleEditor/displaylist.h"
+#include "ConsoleEditor/consoleeditor.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+// Static member initialization
+const int DisplayList::MERGE_LOOKBACK;
+const char DisplayList::MAGIC[4] = { 'C', 'D', 'L', '1' };
+const int DisplayList::MAX_EXTENT;
+const int DisplayList::TEXT_CHUNK_SIZE;
+const char DisplayList::FILL;
+const char DisplayList::SPAN;
+
+//------------------------------------------------------------------------------
+DisplayList::DisplayList() :
+    commands{ },
+    text{ } {
+
+}
+
+//------------------------------------------------------------------------------
+void DisplayList::clear() {
+    commands.clear();
+    text.clear();
+}
+
+//------------------------------------------------------------------------------
+bool DisplayList::empty() const {
+    return commands.empty();
+}
+
+//------------------------------------------------------------------------------
+int DisplayList::size() const {
+    return static_cast<int>(commands.size());
+}
+
+//------------------------------------------------------------------------------
+void DisplayList::addSpan(const Position& pos, const char text[], int length) {
+    if (length <= 0) {
+        return;
+    }
+
+    if (std::find_if(text, text + length, [text](char c) {
+            return c != text[0];
+        }) == text + length) {
+        addFill(Boundary{ pos.col, pos.row, pos.col + length - 1, pos.row },
+                text[0]);
+        return;
+    }
+
+    commands.push_back(DrawCommand{ SPAN, ' ', pos.col, pos.row, length, 1,
+            static_cast<int>(this->text.size()) });
+    this->text.append(text, length);
+}
+
+//------------------------------------------------------------------------------
+void DisplayList::addFill(const Boundary& rect, char fill) {
+    int width = rect.right - rect.left + 1;
+    int height = rect.bottom - rect.top + 1;
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    // Left and right borders alternate with each other row by row, so a few
+    // recent commands are searched instead of only the last. Merging moves the
+    // fill ahead of the commands it skips, so the search stops at the first
+    // command that overlaps the fill
+    int searched = 0;
+    for (auto it = commands.rbegin(); it != commands.rend()
+            && searched < MERGE_LOOKBACK; ++it, ++searched) {
+        if (it->type == FILL && it->fill == fill && it->col == rect.left
+                && it->width == width && it->row + it->height == rect.top) {
+            it->height += height;
+            return;
+        }
+        if (it->col <= rect.right && it->col + it->width - 1 >= rect.left
+                && it->row <= rect.bottom
+                && it->row + it->height - 1 >= rect.top) {
+            break;
+        }
+    }
+
+    commands.push_back(DrawCommand{ FILL, fill, rect.left, rect.top, width,
+            height, 0 });
+}
+
+//------------------------------------------------------------------------------
+void DisplayList::replay(bool drawMode) const {
+    ConsoleEditor& console = ConsoleEditor::getInstance();
+    forEachRow([&console, drawMode](const Position& pos, const char text[],
+            int length) {
+            drawMode ? console.writeToScreen(pos, text, length)
+                    : console.writeToBuffer(pos, text, length);
+        });
+}
+
+//------------------------------------------------------------------------------
+void DisplayList::replay(CellSurface& surface) const {
+    forEachRow([&surface](const Position& pos, const char text[], int length) {
+            surface.record(pos, text, length);
+        });
+}
+
+//------------------------------------------------------------------------------
+void DisplayList::replay(std::vector<std::vector<char>>& frame) const {
+    forEachRow([&frame](const Position& pos, const char text[], int length) {
+            if (pos.row < 0 || pos.row >= (int)frame.size()) {
+                return;
+            }
+
+            std::vector<char>& row = frame[pos.row];
+            int startCol = pos.col < 0 ? 0 : pos.col;
+            int endCol = pos.col + length;
+            if (endCol > (int)row.size()) {
+                endCol = (int)row.size();
+            }
+            if (startCol < endCol) {
+                std::copy(text + (startCol - pos.col),
+                        text + (endCol - pos.col), row.begin() + startCol);
+            }
+        });
+}
+
+//------------------------------------------------------------------------------
+bool DisplayList::save(std::ostream& out) const {
+    out.write(MAGIC, sizeof(MAGIC));
+    writeInt(out, static_cast<int>(commands.size()));
+    writeInt(out, static_cast<int>(text.size()));
+    for (const DrawCommand& command : commands) {
+        out.put(command.type);
+        out.put(command.fill);
+        writeInt(out, command.col);
+        writeInt(out, command.row);
+        writeInt(out, command.width);
+        writeInt(out, command.height);
+        writeInt(out, command.textIdx);
+    }
+    out.write(text.data(), text.size());
+
+    return static_cast<bool>(out);
+}
+
+//------------------------------------------------------------------------------
+bool DisplayList::load(std::istream& in) {
+    clear();
+
+    char magic[sizeof(MAGIC)];
+    if (!in.read(magic, sizeof(magic))
+            || !std::equal(magic, magic + sizeof(magic), MAGIC)) {
+        return false;
+    }
+
+    int commandCount = 0;
+    int textSize = 0;
+    if (!readInt(in, commandCount) || !readInt(in, textSize)
+            || commandCount < 0 || textSize < 0) {
+        return false;
+    }
+
+    std::vector<DrawCommand> loaded;
+    for (int i = 0; i < commandCount; ++i) {
+        DrawCommand command;
+        if (!in.get(command.type) || !in.get(command.fill)
+                || !readInt(in, command.col) || !readInt(in, command.row)
+                || !readInt(in, command.width) || !readInt(in, command.height)
+                || !readInt(in, command.textIdx)) {
+            return false;
+        }
+
+        // Reject commands larger or further out than any console window,
+        // so that the end of a command never overflows, and commands that do
+        // not fit their own text pool
+        bool valid = command.width > 0 && command.width <= MAX_EXTENT
+                && command.height > 0 && command.height <= MAX_EXTENT
+                && command.col >= -MAX_EXTENT && command.col <= MAX_EXTENT
+                && command.row >= -MAX_EXTENT && command.row <= MAX_EXTENT;
+        if (command.type == SPAN) {
+            valid = valid && command.height == 1 && command.textIdx >= 0
+                    && command.textIdx <= textSize - command.width;
+        }
+        else if (command.type != FILL) {
+            valid = false;
+        }
+        if (!valid) {
+            return false;
+        }
+        loaded.push_back(command);
+    }
+
+    // Read the text pool in chunks so that a stream that ends early is
+    // rejected before the whole declared size is allocated
+    std::string loadedText;
+    while (static_cast<int>(loadedText.size()) < textSize) {
+        int readSize = std::min(TEXT_CHUNK_SIZE,
+                textSize - static_cast<int>(loadedText.size()));
+        std::size_t prevSize = loadedText.size();
+        loadedText.resize(prevSize + readSize);
+        if (!in.read(&loadedText[prevSize], readSize)) {
+            return false;
+        }
+    }
+
+    commands.swap(loaded);
+    text.swap(loadedText);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void DisplayList::writeInt(std::ostream& out, int value) {
+    unsigned bits = static_cast<unsigned>(value);
+    char bytes[4];
+    for (int i = 0; i < 4; ++i) {
+        bytes[i] = static_cast<char>((bits >> (i * 8)) & 0xFF);
+    }
+    out.write(bytes, 4);
+}
+
+//------------------------------------------------------------------------------
+bool DisplayList::readInt(std::istream& in, int& value) {
+    unsigned char bytes[4];
+    if (!in.read(reinterpret_cast<char*>(bytes), 4)) {
+        return false;
+    }
+
+    unsigned bits = 0;
+    for (int i = 0; i < 4; ++i) {
+        bits |= static_cast<unsigned>(bytes[i]) << (i * 8);
+    }
+    value = static_cast<int>(bits);
+    return true;
+}
+
+}
\ No newline at end of file
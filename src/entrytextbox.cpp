@@ -4,9 +4,10 @@
 // Author: Franz Alarcon
 //------------------------------------------------------------------------------
 // Description: An EntryTextBox is a type of TextBox that allows the user to
-//     input a text value when the box is interacted. The EntryTextBox stops
-//     reading the user input when the Enter button is clicked or if the user
-//     clicks off the box.
+//     input a text value when the box is interacted. Interacting with the box
+//     gives it the input focus of the active Menu, which then passes keyboard
+//     input to the box. The EntryTextBox stops reading the user input when the
+//     Enter button is clicked or if the user clicks off the box.
 // 
 // Dependencies: TextBox and MenuManager class.
 //------------------------------------------------------------------------------
@@ -50,82 +51,101 @@ EntryTextBox::EntryTextBox(const EntryTextBox& copy) :
 
 //------------------------------------------------------------------------------
 Reply EntryTextBox::interact(inputEvent::MouseEvent action) {
+    textLock.lock();
     userInteracting = true;
-    tryMenuRefresh();
-
-    while (true) {
-        conu::InputEvent input = console.getButtonInput();
+    textLock.unlock();
+    invalidateSurface();
 
-        // Ignore resize and invalid inputs
-        if (input.type == inputEvent::Type::RESIZE_INPUT
-                || input.type == inputEvent::Type::INVALID) {
-            continue;
-        }
-
-        // Cancel interaction if user clicks off box; otherwise ignore mouse
-        if (input.type == inputEvent::Type::MOUSE_INPUT) {
-            if (!posInBounds(input.info.mouse.mousePosition)) {
-                if (cancelHandler) {
-                    textLock.lock();
-                    cancelHandler(userInput);
-                    textLock.unlock();
-                }
-                break;
-            }
-            continue;
-        }
+    MenuManager::getInstance().setFocus(this);
+    tryMenuRefresh();
+    return Reply::CONTINUE;
+}
 
-        // Ignore double inputs from keyup
-        if (!input.info.key.keyedDown) {
-            continue;
-        }
+//------------------------------------------------------------------------------
+Reply EntryTextBox::focusInput(InputEvent input) {
+    // Ignore resize and invalid inputs
+    if (input.type == inputEvent::Type::RESIZE_INPUT
+            || input.type == inputEvent::Type::INVALID) {
+        return Reply::IGNORED;
+    }
 
-        // Process interaction if Enter is pressed
-        const char ENTER_CHAR = (char)13;
-        if (input.info.key.character == ENTER_CHAR) {
-            if (processHandler) {
+    // Cancel interaction if user clicks off box; otherwise ignore mouse
+    if (input.type == inputEvent::Type::MOUSE_INPUT) {
+        if (!posInBounds(input.info.mouse.mousePosition)) {
+            // Release the focus first since the handler may destroy the Box
+            MenuManager::getInstance().releaseFocus(this);
+            if (cancelHandler) {
                 textLock.lock();
-                processHandler(userInput);
+                cancelHandler(userInput);
                 textLock.unlock();
             }
-            break;
-        }
-
-        // Remove character if Backspace is pressed
-        const char BACKSPACE_CHAR = (char)127;
-        if (input.info.key.character == BACKSPACE_CHAR) {
-            if (!userInput.empty()) {
-                textLock.lock();
-                userInput.pop_back();
-                textLock.unlock();
 
-                tryMenuRefresh();
-            }
-            continue;
+            // Let the Menu dispatch the click to the clicked Box
+            return Reply::IGNORED;
         }
+        return Reply::CONTINUE;
+    }
 
-        // Ignore all input outside of the text ascii range
-        const char START_ASCII_RANGE = 32;
-        const char END_ASCII_RANGE = 126;
-        if (input.info.key.character < START_ASCII_RANGE
-                || input.info.key.character > END_ASCII_RANGE) {
-            continue;
+    // Ignore double inputs from keyup
+    if (!input.info.key.keyedDown) {
+        return Reply::CONTINUE;
+    }
+
+    // Process interaction if Enter is pressed
+    const char ENTER_CHAR = (char)13;
+    if (input.info.key.character == ENTER_CHAR) {
+        // Release the focus first since the handler may destroy the Box
+        MenuManager::getInstance().releaseFocus(this);
+        if (processHandler) {
+            textLock.lock();
+            processHandler(userInput);
+            textLock.unlock();
         }
+        return Reply::CONTINUE;
+    }
 
-        if (!inputHandler || inputHandler(input.info.key.character)) {
+    // Remove character if Backspace is pressed
+    const char BACKSPACE_CHAR = (char)127;
+    if (input.info.key.character == BACKSPACE_CHAR) {
+        if (!userInput.empty()) {
             textLock.lock();
-            userInput.push_back(input.info.key.character);
+            userInput.pop_back();
             textLock.unlock();
+            invalidateSurface();
 
             tryMenuRefresh();
         }
+        return Reply::CONTINUE;
     }
 
-    userInteracting = false;
-    tryMenuRefresh();
+    // Ignore all input outside of the text ascii range
+    const char START_ASCII_RANGE = 32;
+    const char END_ASCII_RANGE = 126;
+    if (input.info.key.character < START_ASCII_RANGE
+            || input.info.key.character > END_ASCII_RANGE) {
+        return Reply::CONTINUE;
+    }
+
+    if (!inputHandler || inputHandler(input.info.key.character)) {
+        textLock.lock();
+        userInput.push_back(input.info.key.character);
+        textLock.unlock();
+        invalidateSurface();
+
+        tryMenuRefresh();
+    }
     return Reply::CONTINUE;
 }
 
+//------------------------------------------------------------------------------
+void EntryTextBox::focusLost() {
+    textLock.lock();
+    userInteracting = false;
+    textLock.unlock();
+    invalidateSurface();
+
+    tryMenuRefresh();
+}
 
 //------------------------------------------------------------------------------
 Box* EntryTextBox::copyBox() const {
@@ -146,6 +166,7 @@ std::string EntryTextBox::getClassName() const {
 void EntryTextBox::setText(std::string text) {
 	this->text = text;
 	displayText = text;
+	invalidateSurface();
 }
 
 //------------------------------------------------------------------------------
@@ -168,6 +189,7 @@ void EntryTextBox::setProcessHandler(
 void EntryTextBox::setInput(std::string input) {
     std::lock_guard<std::mutex> lock(textLock);
     userInput = input;
+    invalidateSurface();
 }
 
 //------------------------------------------------------------------------------
@@ -180,6 +202,7 @@ std::string EntryTextBox::getInput() const {
 void EntryTextBox::clearInput() {
     std::lock_guard<std::mutex> lock(textLock);
     userInput.clear();
+    invalidateSurface();
 }
 
 //------------------------------------------------------------------------------
@@ -284,7 +307,7 @@ void EntryTextBox::tryMenuRefresh() const {
         return;
     }
 
-    MenuManager::getInstance().refreshMenu();
+    MenuManager::getInstance().requestRefresh();
 }
 
 /*
@@ -44,9 +44,10 @@ Reply ExitButton::interact(inputEvent::MouseEvent action) {
         return Reply::IGNORED;
     }
 
-    // Execute click handler and return reply
-    if (clickHandler) {
-        clickHandler(*this);
+    // Execute click handler and return reply. Actions that take the
+    // MouseEvent are not run
+    if (clickHandler && !passInput) {
+        clickHandler(*this, action);
     }
     return Reply::EXIT;
 }
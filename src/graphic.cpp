@@ -9,9 +9,15 @@
 //     Graphics are responsible for correctly displaying its canvas given
 //     changes to the dimensions and position of the Graphic at run-time. The
 //     Graphic's Alignment selection will modify how the canvas is displayed
-//     if the visible area is smaller than the size of the canvas.
+//     if the visible area is smaller than the size of the canvas. The canvas
+//     is stored as a single contiguous buffer of rows, and is shared between
+//     copies of a Graphic until one of the copies modifies it. The span of
+//     each row that was modified since the previous print is tracked so that
+//     redrawing the Graphic only prints the modified cells. When buffered as
+//     part of a frame, the Graphic watches its area of the write buffer and
+//     only buffers the modified cells if nothing else was written over it.
 // 
-// Dependencies: ContentBox class.
+// Dependencies: ContentBox class, SharedValue class, and ConsoleEditor class.
 //------------------------------------------------------------------------------
 
 #include "Box/ContentBox/graphic.h"
@@ -22,22 +28,65 @@ const char Graphic::DEFAULT_CANVAS_FILL = ' ';
 
 //------------------------------------------------------------------------------
 Graphic::Graphic() :
-    canvas{ std::vector<char>() } {
+    canvas{ },
+    bufferWatch{ 0 },
+    printedOrigin{ 0, 0 },
+    printedArea{ 0, 0, -1, -1 } {
     
     horizBorderSize = 0;
     vertBorderSize = 0;
+    opaqueBase = true;
     updateCanvasSize();
 }
 
 //------------------------------------------------------------------------------
 Graphic::Graphic(int width, int height) :
-    ContentBox(width, height) {
+    ContentBox(width, height),
+    bufferWatch{ 0 },
+    printedOrigin{ 0, 0 },
+    printedArea{ 0, 0, -1, -1 } {
     
     horizBorderSize = 0;
     vertBorderSize = 0;
+    opaqueBase = true;
     updateCanvasSize();
 }
 
+//------------------------------------------------------------------------------
+Graphic::Graphic(const Graphic& copy) :
+    ContentBox(copy),
+    canvas{ copy.canvas },
+    bufferWatch{ 0 },
+    printedOrigin{ copy.printedOrigin },
+    printedArea{ copy.printedArea } {
+
+    std::lock_guard<std::mutex> lock(copy.dirtyLock);
+    dirtySpans = copy.dirtySpans;
+}
+
+//------------------------------------------------------------------------------
+Graphic& Graphic::operator = (const Graphic& copy) {
+    ContentBox::operator = (copy);
+    canvas = copy.canvas;
+    printedOrigin = copy.printedOrigin;
+    printedArea = copy.printedArea;
+
+    // The printed cells belong to the previous canvas. The spans are sized
+    // from the assigned canvas so that the lock of the copy is not needed
+    std::lock_guard<std::mutex> lock(dirtyLock);
+    dirtySpans.resize(canvas.get().height);
+    std::fill(dirtySpans.begin(), dirtySpans.end(),
+            DirtySpan{ 0, canvas.get().width - 1 });
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+Graphic::~Graphic() {
+    if (bufferWatch != 0) {
+        console.unwatchBufferRegion(bufferWatch);
+    }
+}
+
 //------------------------------------------------------------------------------
 Reply Graphic::interact(inputEvent::MouseEvent action) {
     return Reply::IGNORED;
@@ -64,29 +113,57 @@ void Graphic::setDimensions(int width, int height) {
     updateCanvasSize();
 }
 
+//------------------------------------------------------------------------------
+Reply Graphic::redraw() {
+    if (drawn && printDirty(true)) {
+        return Reply::CONTINUE;
+    }
+
+    return Box::redraw();
+}
+
+//------------------------------------------------------------------------------
+Reply Graphic::rebuffer() {
+    if (drawn && printDirty(false)) {
+        return Reply::CONTINUE;
+    }
+
+    return Box::rebuffer();
+}
+
 //------------------------------------------------------------------------------
 GraphicLine Graphic::operator [] (int idx) {
-    return GraphicLine(canvas[idx]);
+    return GraphicLine(*this, idx);
 }
 
 //------------------------------------------------------------------------------
 GraphicLine Graphic::at(int idx) {
-    if (idx < 0 || static_cast<unsigned>(idx) > canvas.size() - 1) {
+    if (idx < 0 || idx > canvas.get().height - 1) {
         throw std::out_of_range("Index out of range in Graphic::at()");
     }
 
-    return GraphicLine(canvas[idx]);
+    return GraphicLine(*this, idx);
+}
+
+//------------------------------------------------------------------------------
+char Graphic::get(int row, int col) const {
+    const Canvas& current = canvas.get();
+    if (row < 0 || row > current.height - 1 || col < 0
+            || col > current.width - 1) {
+        throw std::out_of_range("Position out of range in Graphic::get()");
+    }
+
+    return getRow(row)[col];
 }
 
 //------------------------------------------------------------------------------
 std::string Graphic::getString() const {
+    const Canvas& current = canvas.get();
     std::string canvasString;
-    canvasString.reserve(targetWidth * targetHeight + targetHeight);
+    canvasString.reserve(current.width * current.height + current.height);
 
-    for (int i = 0; i < targetHeight; ++i) {
-        for (char currChar : canvas[i]) {
-            canvasString.push_back(currChar);
-        }
+    for (int i = 0; i < current.height; ++i) {
+        canvasString.append(getRow(i), current.width);
         canvasString.push_back('\n');
     }
 
@@ -100,82 +177,288 @@ std::string Graphic::getString() const {
 
 //------------------------------------------------------------------------------
 void Graphic::clear() {
-    for (unsigned row = 0; row < canvas.size(); ++row) {
-        std::fill(canvas[row].begin(), canvas[row].end(), ' ');
+    fill(DEFAULT_CANVAS_FILL);
+}
+
+//------------------------------------------------------------------------------
+void Graphic::fill(char fillChar) {
+    std::vector<char>& cells = canvas.edit().cells;
+    std::fill(cells.begin(), cells.end(), fillChar);
+    markAll();
+    invalidateSurface();
+}
+
+//------------------------------------------------------------------------------
+bool Graphic::dirty() const {
+    std::lock_guard<std::mutex> lock(dirtyLock);
+    for (const DirtySpan& span : dirtySpans) {
+        if (span.first <= span.last) {
+            return true;
+        }
     }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------
+Boundary Graphic::getDirtyBoundary() const {
+    std::lock_guard<std::mutex> lock(dirtyLock);
+    Boundary dirtyBound{ 0, 0, -1, -1 };
+    bool found = false;
+    for (int row = 0; row < (int)dirtySpans.size(); ++row) {
+        const DirtySpan& span = dirtySpans[row];
+        if (span.first > span.last) {
+            continue;
+        }
+
+        if (!found) {
+            dirtyBound = Boundary{ span.first, row, span.last, row };
+            found = true;
+            continue;
+        }
+        dirtyBound.left = std::min(dirtyBound.left, span.first);
+        dirtyBound.right = std::max(dirtyBound.right, span.last);
+        dirtyBound.bottom = row;
+    }
+
+    return dirtyBound;
 }
 
 //------------------------------------------------------------------------------
 Reply Graphic::printProtocol(Position pos, Boundary container, bool drawMode) {
-    printBase(pos, container, drawMode);
+    // A buffered frame leaves the previous frame in the write buffer, so only
+    // the modified cells are buffered if nothing covered the Graphic since
+    calculateActualDimAndPos(pos, container);
+    if (!drawMode && drawn && canPrintDirty(drawMode)) {
+        printSpans(drawMode);
+        watchBuffer(drawMode);
+        return Reply::CONTINUE;
+    }
+
+    paintBase(drawMode, nullptr);
     if (actualWidth == 0 || actualHeight == 0) {
         return Reply::CONTINUE;
     }
 
-    // Check for ideal drawing conditions for efficiency (that the canvas is
-    //     fully visible)
-    if (targetWidth == actualWidth - (vertBorderSize * 2)
-        && targetHeight == actualHeight - (horizBorderSize * 2)) {
-        Position currPos = absolutePos;
+    // The base was printed over the whole canvas, so every visible cell is
+    // printed again
+    getPlacement(printedOrigin, printedArea);
+    markAll();
+    printSpans(drawMode);
+    watchBuffer(drawMode);
+
+    drawn = true;
+    return Reply::CONTINUE;
+}
+
+//------------------------------------------------------------------------------
+bool Graphic::printDirty(bool drawMode) {
+    if (!canPrintDirty(drawMode)) {
+        return false;
+    }
+
+    bool tracking = console.overdrawTracking();
+    int prevWriter = OverdrawMap::NO_WRITER;
+    if (tracking) {
+        prevWriter = console.setCellWriter(getClassName());
+    }
+
+    printSpans(drawMode);
+    watchBuffer(drawMode);
+
+    if (tracking) {
+        console.restoreCellWriter(prevWriter);
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool Graphic::canPrintDirty(bool drawMode) {
+    // A retained surface or capture must record every cell of the Graphic
+    if (retained || console.capturing()) {
+        return false;
+    }
+    if (!drawMode && console.bufferRegionDisturbed(bufferWatch)) {
+        return false;
+    }
+
+    Position origin;
+    Boundary visibleArea;
+    getPlacement(origin, visibleArea);
+    return origin.col == printedOrigin.col && origin.row == printedOrigin.row
+            && visibleArea.left == printedArea.left
+            && visibleArea.top == printedArea.top
+            && visibleArea.right == printedArea.right
+            && visibleArea.bottom == printedArea.bottom;
+}
+
+//------------------------------------------------------------------------------
+void Graphic::printSpans(bool drawMode) {
+    // Printing only reads the canvas so that a shared canvas stays shared
+    const Canvas& canvas = this->canvas.get();
+
+    // Clip the canvas to the visible area once
+    int firstCol = std::max(0, printedArea.left - printedOrigin.col);
+    int lastCol = std::min(canvas.width - 1,
+            printedArea.right - printedOrigin.col);
+    int firstRow = std::max(0, printedArea.top - printedOrigin.row);
+    int lastRow = std::min(canvas.height - 1,
+            printedArea.bottom - printedOrigin.row);
+    if (firstRow > lastRow) {
+        return;
+    }
+
+    // Take the visible segment of each modified row under the lock, leaving
+    // the segments outside the visible area and any cell modified after this
+    // point to be printed later
+    std::vector<DirtySpan> segments(lastRow - firstRow + 1,
+            DirtySpan{ 0, -1 });
+    {
+        std::lock_guard<std::mutex> lock(dirtyLock);
+        for (int row = firstRow; row <= lastRow; ++row) {
+            DirtySpan& span = dirtySpans[row];
+            int spanFirst = std::max(firstCol, span.first);
+            int spanLast = std::min(lastCol, span.last);
+            if (spanFirst > spanLast) {
+                continue;
+            }
+            segments[row - firstRow] = DirtySpan{ spanFirst, spanLast };
 
-        for (unsigned i = 0; i < canvas.size(); ++i) {
-            canvas[i].push_back('\0');
-            printLine(currPos, &canvas[i][0], drawMode);
-            canvas[i].pop_back();
-            ++currPos.row;
+            // A span cut on both sides stays whole to remain a single span
+            bool leftOver = span.first < spanFirst;
+            bool rightOver = span.last > spanLast;
+            if (leftOver && rightOver) {
+                continue;
+            }
+            if (leftOver) {
+                span.last = spanFirst - 1;
+            }
+            else if (rightOver) {
+                span.first = spanLast + 1;
+            }
+            else {
+                span = DirtySpan{ 0, -1 };
+            }
         }
+    }
 
-        drawn = true;
-        return Reply::CONTINUE;
+    // Print the modified segment of each visible row as a single span
+    for (int row = firstRow; row <= lastRow; ++row) {
+        const DirtySpan& span = segments[row - firstRow];
+        if (span.first <= span.last) {
+            printLine(Position{ printedOrigin.col + span.first,
+                    printedOrigin.row + row }, getRow(row) + span.first,
+                    span.last - span.first + 1, drawMode);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void Graphic::watchBuffer(bool drawMode) {
+    // Cells drawn to the screen are missing from the write buffer, so the
+    // next buffered print must be in full
+    if (drawMode) {
+        if (bufferWatch != 0) {
+            console.unwatchBufferRegion(bufferWatch);
+            bufferWatch = 0;
+        }
+        return;
+    }
+
+    bufferWatch = console.watchBufferRegion(bufferWatch, Boundary{
+        absolutePos.col,                        // Left
+        absolutePos.row,                        // Top
+        absolutePos.col + actualWidth - 1,      // Right
+        absolutePos.row + actualHeight - 1      // Bottom
+    });
+}
+
+//------------------------------------------------------------------------------
+void Graphic::getPlacement(Position& origin, Boundary& visibleArea) {
+    // Check for ideal drawing conditions (that the canvas is fully visible)
+    if (targetWidth == actualWidth - (vertBorderSize * 2)
+        && targetHeight == actualHeight - (horizBorderSize * 2)) {
+        origin = absolutePos;
+        visibleArea = Boundary{
+            absolutePos.col,                    // Left
+            absolutePos.row,                    // Top
+            absolutePos.col + targetWidth - 1,  // Right
+            absolutePos.row + targetHeight - 1  // Bottom
+        };
+        return;
     }
 
     // Canvas obscured due to resizing or borders condition
-    Boundary visibleArea{
+    visibleArea = Boundary{
         absolutePos.col + vertBorderSize,   // Left
         absolutePos.row + horizBorderSize,  // Top
         absolutePos.col + actualWidth - 1 - vertBorderSize,     // Right
         absolutePos.row + actualHeight - 1 - horizBorderSize    // Bottom
     };
-    int horizOffset = getHorizontalOffset();
-    int vertOffset = getVerticalOffset();
-
-    Position currPos{
-        absolutePos.col + horizOffset,  // Col
-        absolutePos.row + vertOffset    // Row
+    origin = Position{
+        absolutePos.col + getHorizontalOffset(),    // Col
+        absolutePos.row + getVerticalOffset()       // Row
     };
-    int maxRow = absolutePos.row + canvas.size();
-    for (unsigned row = 0; row < canvas.size(); ++row) {
-        currPos.col = absolutePos.col + horizOffset;
-
-        int rowSize = canvas[row].size();
-        for (int col = 0; col < rowSize; ++col) {
-            // Print cell if it is in the visible canvas area
-            if (currPos.row >= visibleArea.top
-                && currPos.row <= visibleArea.bottom
-                && currPos.col >= visibleArea.left
-                && currPos.col <= visibleArea.right) {
-                char cStr[2] = { canvas[row][col], '\0' };
-                printLine(currPos, cStr, drawMode);
-            }
-
-            ++currPos.col;
-        }
+}
 
-        ++currPos.row;
+//------------------------------------------------------------------------------
+void Graphic::markDirty(int row, int first, int last) {
+    std::lock_guard<std::mutex> lock(dirtyLock);
+    DirtySpan& span = dirtySpans[row];
+    if (span.first > span.last) {
+        span = DirtySpan{ first, last };
+        return;
     }
 
-    drawn = true;
-    return Reply::CONTINUE;
+    span.first = std::min(span.first, first);
+    span.last = std::max(span.last, last);
+}
+
+//------------------------------------------------------------------------------
+void Graphic::markAll() {
+    std::lock_guard<std::mutex> lock(dirtyLock);
+    std::fill(dirtySpans.begin(), dirtySpans.end(),
+            DirtySpan{ 0, canvas.get().width - 1 });
 }
 
 //------------------------------------------------------------------------------
 void Graphic::updateCanvasSize() {
-    canvas.resize(targetHeight, 
-            std::vector<char>(targetWidth, DEFAULT_CANVAS_FILL));
+    // Keep a shared canvas shared if its size does not change
+    const Canvas& current = canvas.get();
+    if (current.width == targetWidth && current.height == targetHeight) {
+        return;
+    }
 
-    for (int i = 0; i < targetHeight; ++i) {
-        canvas[i].resize(targetWidth, DEFAULT_CANVAS_FILL);
+    // Copy the overlapping area of the old canvas into the resized buffer
+    Canvas resized{ targetWidth, targetHeight,
+            std::vector<char>(targetWidth * targetHeight,
+            DEFAULT_CANVAS_FILL) };
+    int copyWidth = std::min(current.width, resized.width);
+    int copyHeight = std::min(current.height, resized.height);
+    for (int i = 0; i < copyHeight; ++i) {
+        const char* src = current.cells.data() + i * current.width;
+        std::copy(src, src + copyWidth,
+                resized.cells.begin() + i * resized.width);
     }
+
+    canvas = std::move(resized);
+    {
+        std::lock_guard<std::mutex> lock(dirtyLock);
+        dirtySpans.resize(targetHeight);
+    }
+    markAll();
+}
+
+//------------------------------------------------------------------------------
+const char* Graphic::getRow(int row) const {
+    const Canvas& current = canvas.get();
+    return current.cells.data() + row * current.width;
+}
+
+//------------------------------------------------------------------------------
+char* Graphic::editRow(int row) {
+    Canvas& current = canvas.edit();
+    return current.cells.data() + row * current.width;
 }
 
 //------------------------------------------------------------------------------
@@ -214,47 +497,59 @@ int Graphic::getVerticalOffset() {
 // GraphicLine class methods
 
 //------------------------------------------------------------------------------
-GraphicLine::GraphicLine(std::vector<char>& line) :
-    canvasLine{ &line } {
+GraphicLine::GraphicLine(Graphic& graphic, int row) :
+    graphic{ &graphic },
+    row{ row } {
 
 }
 
 //------------------------------------------------------------------------------
 void GraphicLine::operator = (std::string lineText) {
-    int idx = 0;
-
-    int stringSize = lineText.size();
-    int lineSize = canvasLine->size();
-    while (idx < stringSize && idx < lineSize) {
-        (*canvasLine)[idx] = lineText[idx];
-        ++idx;
+    int copyLength = std::min(static_cast<int>(lineText.size()), size());
+    std::copy(lineText.begin(), lineText.begin() + copyLength,
+            graphic->editRow(row));
+    if (copyLength > 0) {
+        graphic->markDirty(row, 0, copyLength - 1);
     }
+    graphic->invalidateSurface();
 }
 
 //------------------------------------------------------------------------------
 char& GraphicLine::operator [] (int idx) {
-    return (*canvasLine)[idx];
+    // The returned cell may be written to at any time
+    graphic->markDirty(row, idx, idx);
+    graphic->invalidateSurface();
+    return graphic->editRow(row)[idx];
 }
 
 //------------------------------------------------------------------------------
 char& GraphicLine::at(int idx) {
-    if (idx < 0 || static_cast<unsigned>(idx) > canvasLine->size() - 1) {
+    if (idx < 0 || idx > size() - 1) {
         throw std::out_of_range("Index out of range in GraphicsLine::at()");
     }
 
-    return (*canvasLine)[idx];
+    graphic->markDirty(row, idx, idx);
+    graphic->invalidateSurface();
+    return graphic->editRow(row)[idx];
 }
 
 //------------------------------------------------------------------------------
-std::string GraphicLine::getString() const {
-    std::string lineString;
-    lineString.reserve(canvasLine->size());
-
-    for (char currChar : *canvasLine) {
-        lineString.push_back(currChar);
+char GraphicLine::get(int idx) const {
+    if (idx < 0 || idx > size() - 1) {
+        throw std::out_of_range("Index out of range in GraphicsLine::get()");
     }
-    return lineString;
+
+    return graphic->getRow(row)[idx];
 }
 
+//------------------------------------------------------------------------------
+std::string GraphicLine::getString() const {
+    return std::string(graphic->getRow(row), size());
+}
+
+//------------------------------------------------------------------------------
+int GraphicLine::size() const {
+    return graphic->canvas.get().width;
+}
 
 }
\ No newline at end of file
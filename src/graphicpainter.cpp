@@ -0,0 +1,414 @@
+//------------------------------------------------------------------------------
+// graphicpainter.cpp
+// Implementation for the GraphicPainter class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: A GraphicPainter draws shapes onto the canvas of a Graphic.
+//     Lines, rectangles, circles, and ellipses can be drawn as outlines or
+//     filled, enclosed regions can be flood filled, and rectangular areas of
+//     the canvas can be copied or moved. Shapes are clipped to the canvas and
+//     are written as whole row spans wherever possible, so drawing a shape
+//     costs about as much as the amount of rows it covers. A GraphicPainter
+//     is a lightweight view of its Graphic and does not own any cells.
+//
+// Dependencies: Graphic class.
+//------------------------------------------------------------------------------
+
+#include "Box/ContentBox/graphicpainter.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+GraphicPainter::GraphicPainter(Graphic& graphic) :
+    graphic{ &graphic } {
+
+}
+
+//------------------------------------------------------------------------------
+void GraphicPainter::drawLine(Position from, Position to, char brush) {
+    Graphic::Canvas& canvas = graphic->canvas.edit();
+    if (!clipLine(canvas, from, to)) {
+        return;
+    }
+
+    // Bresenham's line algorithm between the clipped endpoints. Consecutive
+    // cells on the same row are collected into a run and filled as a single
+    // span
+    int deltaCol = std::abs(to.col - from.col);
+    int deltaRow = -std::abs(to.row - from.row);
+    int stepCol = from.col < to.col ? 1 : -1;
+    int stepRow = from.row < to.row ? 1 : -1;
+    int err = deltaCol + deltaRow;
+
+    int col = from.col;
+    int row = from.row;
+    int runStart = col;
+    while (col != to.col || row != to.row) {
+        int nextCol = col;
+        int nextRow = row;
+        int err2 = err * 2;
+        if (err2 >= deltaRow) {
+            err += deltaRow;
+            nextCol += stepCol;
+        }
+        if (err2 <= deltaCol) {
+            err += deltaCol;
+            nextRow += stepRow;
+        }
+
+        if (nextRow != row) {
+            fillSpan(canvas, row, std::min(runStart, col),
+                    std::max(runStart, col), brush);
+            runStart = nextCol;
+        }
+        col = nextCol;
+        row = nextRow;
+    }
+    fillSpan(canvas, row, std::min(runStart, col), std::max(runStart, col),
+            brush);
+
+    graphic->invalidateSurface();
+}
+
+//------------------------------------------------------------------------------
+void GraphicPainter::drawRect(Boundary rect, char brush) {
+    if (rect.left > rect.right || rect.top > rect.bottom) {
+        return;
+    }
+
+    Graphic::Canvas& canvas = graphic->canvas.edit();
+    fillSpan(canvas, rect.top, rect.left, rect.right, brush);
+    if (rect.bottom != rect.top) {
+        fillSpan(canvas, rect.bottom, rect.left, rect.right, brush);
+    }
+
+    // Only the rows within the canvas are visited for the sides
+    int firstRow = std::max(rect.top + 1, 0);
+    int lastRow = std::min(rect.bottom - 1, canvas.height - 1);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        fillSpan(canvas, row, rect.left, rect.left, brush);
+        fillSpan(canvas, row, rect.right, rect.right, brush);
+    }
+
+    graphic->invalidateSurface();
+}
+
+//------------------------------------------------------------------------------
+void GraphicPainter::fillRect(Boundary rect, char brush) {
+    Graphic::Canvas& canvas = graphic->canvas.edit();
+    if (!clipRect(canvas, rect)) {
+        return;
+    }
+
+    for (int row = rect.top; row <= rect.bottom; ++row) {
+        fillSpan(canvas, row, rect.left, rect.right, brush);
+    }
+    graphic->invalidateSurface();
+}
+
+//------------------------------------------------------------------------------
+void GraphicPainter::drawEllipse(Boundary bounds, char brush) {
+    traceEllipse(bounds, brush, false);
+}
+
+//------------------------------------------------------------------------------
+void GraphicPainter::fillEllipse(Boundary bounds, char brush) {
+    traceEllipse(bounds, brush, true);
+}
+
+//------------------------------------------------------------------------------
+void GraphicPainter::drawCircle(Position center, int radius, char brush) {
+    if (radius < 0) {
+        return;
+    }
+
+    traceEllipse(Boundary{ center.col - radius, center.row - radius,
+            center.col + radius, center.row + radius }, brush, false);
+}
+
+//------------------------------------------------------------------------------
+void GraphicPainter::fillCircle(Position center, int radius, char brush) {
+    if (radius < 0) {
+        return;
+    }
+
+    traceEllipse(Boundary{ center.col - radius, center.row - radius,
+            center.col + radius, center.row + radius }, brush, true);
+}
+
+//------------------------------------------------------------------------------
+int GraphicPainter::floodFill(Position seed, char brush) {
+    const Graphic::Canvas& current = graphic->canvas.get();
+    if (seed.col < 0 || seed.col >= current.width
+            || seed.row < 0 || seed.row >= current.height) {
+        return 0;
+    }
+
+    char target = current.cells[seed.row * current.width + seed.col];
+    if (target == brush) {
+        return 0;
+    }
+
+    // Scanline flood fill: each popped seed is widened into the longest run
+    // of target cells on its row, the run is filled as a single span, and a
+    // seed is pushed for every run of target cells directly above and below
+    Graphic::Canvas& canvas = graphic->canvas.edit();
+    std::vector<Position> seeds{ seed };
+    int filled = 0;
+    while (!seeds.empty()) {
+        Position curr = seeds.back();
+        seeds.pop_back();
+
+        const char* cells = canvas.cells.data() + curr.row * canvas.width;
+        if (cells[curr.col] != target) {
+            continue;
+        }
+
+        int left = curr.col;
+        int right = curr.col;
+        while (left > 0 && cells[left - 1] == target) {
+            --left;
+        }
+        while (right < canvas.width - 1 && cells[right + 1] == target) {
+            ++right;
+        }
+        fillSpan(canvas, curr.row, left, right, brush);
+        filled += right - left + 1;
+
+        for (int adjRow = curr.row - 1; adjRow <= curr.row + 1; adjRow += 2) {
+            if (adjRow < 0 || adjRow >= canvas.height) {
+                continue;
+            }
+
+            const char* adjCells = canvas.cells.data() + adjRow * canvas.width;
+            bool inRun = false;
+            for (int col = left; col <= right; ++col) {
+                if (adjCells[col] != target) {
+                    inRun = false;
+                    continue;
+                }
+                if (!inRun) {
+                    seeds.push_back(Position{ col, adjRow });
+                    inRun = true;
+                }
+            }
+        }
+    }
+
+    graphic->invalidateSurface();
+    return filled;
+}
+
+//------------------------------------------------------------------------------
+void GraphicPainter::copyRect(Boundary source, Position dest) {
+    Graphic::Canvas& canvas = graphic->canvas.edit();
+    int shiftCol = dest.col - source.left;
+    int shiftRow = dest.row - source.top;
+
+    // Clip the source to the canvas, then clip its destination and apply the
+    // same clip back onto the source
+    if (!clipRect(canvas, source)) {
+        return;
+    }
+    Boundary target{ source.left + shiftCol, source.top + shiftRow,
+            source.right + shiftCol, source.bottom + shiftRow };
+    if (!clipRect(canvas, target)) {
+        return;
+    }
+    source = Boundary{ target.left - shiftCol, target.top - shiftRow,
+            target.right - shiftCol, target.bottom - shiftRow };
+
+    // Copy rows away from the direction of the shift so that overlapping
+    // source rows are read before they are overwritten. Overlap within a row
+    // is handled by memmove
+    int width = target.right - target.left + 1;
+    int height = target.bottom - target.top + 1;
+    for (int i = 0; i < height; ++i) {
+        int offset = shiftRow > 0 ? height - 1 - i : i;
+        char* cells = canvas.cells.data();
+        std::memmove(cells + (target.top + offset) * canvas.width
+                + target.left, cells + (source.top + offset) * canvas.width
+                + source.left, width);
+        graphic->markDirty(target.top + offset, target.left, target.right);
+    }
+
+    graphic->invalidateSurface();
+}
+
+//------------------------------------------------------------------------------
+void GraphicPainter::moveRect(Boundary source, Position dest, char fillChar) {
+    Graphic::Canvas& canvas = graphic->canvas.edit();
+    int shiftCol = dest.col - source.left;
+    int shiftRow = dest.row - source.top;
+    if (!clipRect(canvas, source)) {
+        return;
+    }
+
+    copyRect(source, Position{ source.left + shiftCol, source.top + shiftRow });
+
+    // Fill the source cells that were left uncovered by the moved rectangle
+    Boundary moved{ source.left + shiftCol, source.top + shiftRow,
+            source.right + shiftCol, source.bottom + shiftRow };
+    for (int row = source.top; row <= source.bottom; ++row) {
+        if (row < moved.top || row > moved.bottom) {
+            fillSpan(canvas, row, source.left, source.right, fillChar);
+            continue;
+        }
+
+        fillSpan(canvas, row, source.left,
+                std::min(source.right, moved.left - 1), fillChar);
+        fillSpan(canvas, row, std::max(source.left, moved.right + 1),
+                source.right, fillChar);
+    }
+
+    graphic->invalidateSurface();
+}
+
+//------------------------------------------------------------------------------
+void GraphicPainter::fillSpan(Graphic::Canvas& canvas, int row, int first,
+        int last, char brush) {
+    if (row < 0 || row >= canvas.height) {
+        return;
+    }
+
+    first = std::max(first, 0);
+    last = std::min(last, canvas.width - 1);
+    if (first > last) {
+        return;
+    }
+
+    char* cells = canvas.cells.data() + row * canvas.width;
+    std::fill(cells + first, cells + last + 1, brush);
+    graphic->markDirty(row, first, last);
+}
+
+//------------------------------------------------------------------------------
+void GraphicPainter::traceEllipse(Boundary bounds, char brush, bool filled) {
+    Graphic::Canvas& canvas = graphic->canvas.edit();
+    bounds = Boundary{ std::min(bounds.left, bounds.right),
+            std::min(bounds.top, bounds.bottom),
+            std::max(bounds.left, bounds.right),
+            std::max(bounds.top, bounds.bottom) };
+
+    // The span of each row is computed directly, so only the rows of the
+    // ellipse within the canvas are visited no matter how large it is
+    int firstRow = std::max(bounds.top, 0);
+    int lastRow = std::min(bounds.bottom, canvas.height - 1);
+    double centerRow = (static_cast<double>(bounds.top) + bounds.bottom) / 2;
+    for (int row = firstRow; row <= lastRow; ++row) {
+        int first;
+        int last;
+        ellipseSpan(bounds, row, first, last);
+
+        // An outline covers the part of the span that is not covered by the
+        // span of the next row away from the middle
+        int outerRow = row < centerRow ? row - 1 : row + 1;
+        if (filled || outerRow < bounds.top || outerRow > bounds.bottom) {
+            fillSpan(canvas, row, first, last, brush);
+            continue;
+        }
+
+        int outerFirst;
+        int outerLast;
+        ellipseSpan(bounds, outerRow, outerFirst, outerLast);
+        int leftEnd = outerFirst > first ? outerFirst - 1 : first;
+        int rightStart = outerLast < last ? outerLast + 1 : last;
+        if (static_cast<long long>(rightStart) - leftEnd <= 1) {
+            fillSpan(canvas, row, first, last, brush);
+        }
+        else {
+            fillSpan(canvas, row, first, leftEnd, brush);
+            fillSpan(canvas, row, rightStart, last, brush);
+        }
+    }
+
+    graphic->invalidateSurface();
+}
+
+//------------------------------------------------------------------------------
+void GraphicPainter::ellipseSpan(const Boundary& bounds, int row, int& first,
+        int& last) {
+    // The ellipse touches the outer edges of the cells on the sides of its
+    // rectangle. A cell is within the span if its center is within the ellipse
+    double centerCol = (static_cast<double>(bounds.left) + bounds.right) / 2;
+    double centerRow = (static_cast<double>(bounds.top) + bounds.bottom) / 2;
+    double radiusCol = (static_cast<double>(bounds.right) - bounds.left + 1)
+            / 2;
+    double radiusRow = (static_cast<double>(bounds.bottom) - bounds.top + 1)
+            / 2;
+    double offset = (row - centerRow) / radiusRow;
+    double half = radiusCol * std::sqrt(std::max(1 - offset * offset, 0.0));
+
+    // The tips of tall ellipses always keep their middle cells
+    first = static_cast<int>(std::ceil(centerCol - half));
+    last = static_cast<int>(std::floor(centerCol + half));
+    if (first > last) {
+        first = static_cast<int>(std::floor(centerCol));
+        last = static_cast<int>(std::ceil(centerCol));
+    }
+    first = std::max(first, bounds.left);
+    last = std::min(last, bounds.right);
+}
+
+//------------------------------------------------------------------------------
+bool GraphicPainter::clipLine(const Graphic::Canvas& canvas, Position& from,
+        Position& to) {
+    // Liang-Barsky line clipping. The line is from + t * delta for t from 0
+    // to 1, and each canvas edge narrows the range of t within the canvas
+    double deltaCol = static_cast<double>(to.col) - from.col;
+    double deltaRow = static_cast<double>(to.row) - from.row;
+    double edgeDir[4] = { -deltaCol, deltaCol, -deltaRow, deltaRow };
+    double edgeDist[4] = { static_cast<double>(from.col),
+            canvas.width - 1.0 - from.col, static_cast<double>(from.row),
+            canvas.height - 1.0 - from.row };
+    double enter = 0;
+    double exit = 1;
+    for (int i = 0; i < 4; ++i) {
+        if (edgeDir[i] == 0) {
+            if (edgeDist[i] < 0) {
+                return false;
+            }
+            continue;
+        }
+
+        double t = edgeDist[i] / edgeDir[i];
+        if (edgeDir[i] < 0) {
+            enter = std::max(enter, t);
+        }
+        else {
+            exit = std::min(exit, t);
+        }
+    }
+    if (enter > exit) {
+        return false;
+    }
+
+    // Endpoints within the canvas are kept exactly
+    Position start = from;
+    if (enter > 0) {
+        from.col = clipCoord(start.col + enter * deltaCol, canvas.width);
+        from.row = clipCoord(start.row + enter * deltaRow, canvas.height);
+    }
+    if (exit < 1) {
+        to.col = clipCoord(start.col + exit * deltaCol, canvas.width);
+        to.row = clipCoord(start.row + exit * deltaRow, canvas.height);
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+int GraphicPainter::clipCoord(double coord, int extent) {
+    return std::min(std::max(static_cast<int>(std::floor(coord + 0.5)), 0),
+            extent - 1);
+}
+
+//------------------------------------------------------------------------------
+bool GraphicPainter::clipRect(const Graphic::Canvas& canvas, Boundary& rect) {
+    rect.left = std::max(rect.left, 0);
+    rect.top = std::max(rect.top, 0);
+    rect.right = std::min(rect.right, canvas.width - 1);
+    rect.bottom = std::min(rect.bottom, canvas.height - 1);
+    return rect.left <= rect.right && rect.top <= rect.bottom;
+}
+
+}
\ No newline at end of file
@@ -33,16 +33,19 @@ HorizContainer::HorizContainer(
     const HorizContainer& cpy) :
     BoxContainer(cpy) {
 
-    for (auto it = cpy.contents.begin(); it != cpy.contents.end(); ++it) {
-        this->contents[it->first].item = it->second.item->copyBox();
-    }
+}
+
+//------------------------------------------------------------------------------
+HorizContainer::HorizContainer(HorizContainer&& move) :
+    BoxContainer(std::move(move)) {
+
 }
 
 //------------------------------------------------------------------------------
 Reply HorizContainer::interact(inputEvent::MouseEvent action) {
     for (auto it = contents.begin(); it != contents.end(); ++it) {
-        if (it->second.item->posInBounds(action.mousePosition)) {
-            return it->second.item->interact(action);
+        if (it->item->posInBounds(action.mousePosition)) {
+            return it->item->interact(action);
         }
     }
 
@@ -68,7 +71,7 @@ std::string HorizContainer::getClassName() const {
 int HorizContainer::getContentHeight() const {
     int maxHeight = 0;
     for (auto it = contents.begin(); it != contents.end(); ++it) {
-        maxHeight = std::max<int>(maxHeight, it->second.item->getHeight());
+        maxHeight = std::max<int>(maxHeight, it->item->getHeight());
     }
     maxHeight += horizBorderSize * 2;
 
@@ -79,7 +82,7 @@ int HorizContainer::getContentHeight() const {
 int HorizContainer::getContentWidth() const {
     int maxWidth = 0;
     for (auto it = contents.begin(); it != contents.end(); ++it) {
-        maxWidth += it->second.item->getWidth();
+        maxWidth += it->item->getWidth();
     }
     maxWidth += vertBorderSize * 2;
 
@@ -89,68 +92,66 @@ int HorizContainer::getContentWidth() const {
 //------------------------------------------------------------------------------
 Reply HorizContainer::printProtocol(Position pos, Boundary container,
         bool drawMode) {
-    // Get acutal dimensions and print base
+    // Get acutal dimensions
     int prevTargWidth = targetWidth;
     int prevTargHeight = targetHeight;
     targetWidth = getWidth();
     targetHeight = getHeight();
-    printBase(pos, container, drawMode);
+    calculateActualDimAndPos(pos, container);
     targetWidth = prevTargWidth;
     targetHeight = prevTargHeight;
 
     // Check if there is anything to print
     if (contents.empty()) {
+        paintBase(drawMode, nullptr);
         return Reply::CONTINUE;
     }
 
+    // Arrange contents, then print the base and the visible contents
+    layout(pos);
+    printContents(drawMode);
+
+    drawn = true;
+    return Reply::CONTINUE;
+}
+
+//------------------------------------------------------------------------------
+void HorizContainer::arrangeContents(const Position& pos,
+        const Boundary& contentBound) {
     // Get total content width
     int totalWidth = 0;
     int dynamCount = 0;
     for (auto it = contents.begin(); it != contents.end(); ++it) {
-        if (!it->second.fixed) {
-            totalWidth += it->second.item->getWidth();
+        if (!it->fixed) {
+            totalWidth += it->item->getWidth();
             ++dynamCount;
         }
     }
 
-    // Get content space boundary and width spacing
-    Boundary contentBound = getContentBound(absolutePos);
+    // Get content spacing
     std::vector<int> spacing = getSpacingWidth(contentBound, totalWidth,
         dynamCount);
 
-    // Print contents
+    // Get the print position of each content Box
+    arrangement.reserve(contents.size());
     int spacingIdx = spacing.size() - 1;
     Position offset{ actualWidth - vertBorderSize, 0 };
     for (auto it = contents.rbegin(); it != contents.rend(); ++it) {
-        if (it->second.fixed) {
-            Position drawPos{ it->second.pos.col + pos.col, it->second.pos.row
+        if (it->fixed) {
+            Position drawPos{ it->pos.col + pos.col, it->pos.row
                     + pos.row };
-
-            if (drawMode) {
-                it->second.item->draw(drawPos, contentBound);
-            }
-            else {
-                it->second.item->buffer(drawPos, contentBound);
-            }
+            arrangement.push_back(ItemPlacement{ it->item, drawPos });
         }
         else {
-            int itemWidth = it->second.item->getWidth();
+            int itemWidth = it->item->getWidth();
             offset.col -= spacing[spacingIdx--] + itemWidth;
-            offset.row = getRowOffset(it->second.item->getHeight());
-
-            if (drawMode) {
-                it->second.item->draw(Position{ absolutePos.col + offset.col,
-                        absolutePos.row + offset.row }, contentBound);
-            }
-            else {
-                it->second.item->buffer(Position{ absolutePos.col + offset.col,
-                        absolutePos.row + offset.row }, contentBound);
-            }
+            offset.row = getRowOffset(it->item->getHeight());
+
+            arrangement.push_back(ItemPlacement{ it->item,
+                    Position{ absolutePos.col + offset.col,
+                    absolutePos.row + offset.row } });
         }
     }
-
-    drawn = true;
-    return Reply::CONTINUE;
 }
 
 //------------------------------------------------------------------------------
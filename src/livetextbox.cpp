@@ -68,7 +68,10 @@ std::string LiveTextBox::getClassName() const {
 //------------------------------------------------------------------------------
 Reply LiveTextBox::printProtocol(Position pos, Boundary container,
         bool drawMode) {
+    // The live variable can change at any time, so a retained surface is
+    // never reused
     updateTextBoxContent();
+    invalidateSurface();
     return TextBox::printProtocol(pos, container, drawMode);
 }
 
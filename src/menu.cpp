@@ -32,20 +32,28 @@ MenuOptions::MenuOptions() :
     backgroundTrans{ false },
     resizeScreen{ false },
     useBuffering{ true },
+    usePipelining{ false },
     useAutoPrint{ true },
-    frameRate{ DEFAULT_FRAME_RATE } {
+    useArena{ false },
+    trackOverdraw{ false },
+    showOverdraw{ false },
+    frameRate{ DEFAULT_FRAME_RATE },
+    fullPrintInterval{ DEFAULT_FULL_PRINT_INTERVAL } {
 
 }
 
 //------------------------------------------------------------------------------
 Menu::Menu() :
+    arena{ nullptr },
     container{ VertContainer(MAXIMUM, MAXIMUM) },
+    focusBox{ },
     exitMenu{ false },
     exitReply{ Reply::CONTINUE },
     screenWidth{ -1 },
     screenHeight{ -1 },
     prevScreenWidth{ -1 },
-    prevScreenHeight{ -1 } {
+    prevScreenHeight{ -1 },
+    printsSinceFullWrite{ 0 } {
 
 }
 
@@ -61,27 +69,12 @@ ItemAccessor Menu::operator [] (int layer) {
 
 //------------------------------------------------------------------------------
 Reply Menu::enter() {
-    exitMenu = false;
-    manager.pushMenu(*this);
-
-    prevScreenWidth = console.getWindowWidth();
-    prevScreenHeight = console.getWindowHeight();
-    resizeScreen();
-
-    if (options.printOnEnter) {
-        print();
+    if (manager.navigating()) {
+        manager.pushNavigation(*this);
+        return Reply::CONTINUE;
     }
 
-    entryLoop();
-
-    if (options.clearOnExit) {
-        console.clearScreen();
-    }
-    if (options.resizeScreen) {
-        console.setWindowDimensions(prevScreenWidth, prevScreenHeight);
-    }
-    manager.popMenu();
-    return exitReply;
+    return manager.navigate(*this);
 }
 
 //------------------------------------------------------------------------------
@@ -89,31 +82,70 @@ void Menu::print() {
     std::lock_guard<std::mutex> lock(printLock);
 
     container.backgroundTransparent(options.backgroundTrans);
+    bool tracking = options.trackOverdraw || options.showOverdraw;
+    if (tracking) {
+        console.setOverdrawTracking(true);
+    }
+
     if (options.useBuffering) {
-        container.buffer(Position{ 0, 0 }, console.getWindowBoundary());
-        console.printWriteBuffer();
+        // Hold the write buffer for the whole frame so contained Boxes can be
+        // buffered in parallel without locking on every write
+        Boundary winBound = console.getWindowBoundary();
+        console.lockWriteBuffer();
+        container.buffer(Position{ 0, 0 }, winBound);
+        if (tracking) {
+            finishOverdraw(false);
+        }
+        console.unlockWriteBuffer();
+        BoxContainer::endFrame();
+
+        // Only changed cells are written to the window screen, so the whole
+        // frame is written now and then
+        if (options.fullPrintInterval > 0
+                && ++printsSinceFullWrite >= options.fullPrintInterval) {
+            console.invalidateShownFrame();
+            printsSinceFullWrite = 0;
+        }
+
+        if (options.usePipelining) {
+            console.startPresenter();
+            console.presentWriteBuffer();
+        }
+        else {
+            console.printWriteBuffer();
+        }
         return;
     }
 
     container.draw(Position{ 0, 0 }, console.getWindowBoundary());
+    if (tracking) {
+        finishOverdraw(true);
+    }
+    BoxContainer::endFrame();
 }
 
 //------------------------------------------------------------------------------
 void Menu::insert(const Box& inBox) {
+    BoxArena::Scope scope(getArena());
     container.insert(inBox);
 }
 
 //------------------------------------------------------------------------------
 void Menu::insert(int layer, const Box& inBox) {
+    BoxArena::Scope scope(getArena());
     container.insert(layer, inBox);
 }
 
 //------------------------------------------------------------------------------
 void Menu::insert(int layer, const Box& inBox, const Position& pos) {
+    BoxArena::Scope scope(getArena());
     container.insert(layer, inBox, pos);
 }
 
 void Menu::remove(int layer) {
+    if (focusBox && focusBox.get() == container.get(layer)) {
+        setFocus(nullptr);
+    }
     container.remove(layer);
 }
 
@@ -127,6 +159,11 @@ Box* Menu::getRecent() const {
     return container.getRecent();
 }
 
+//------------------------------------------------------------------------------
+void Menu::unbind(const std::string& name) {
+    boundBoxes.erase(name);
+}
+
 //------------------------------------------------------------------------------
 void Menu::setAlignment(Align alignment) {
     container.setAlignment(alignment);
@@ -156,6 +193,11 @@ const MenuOptions& Menu::getOptions() const {
     return options;
 }
 
+//------------------------------------------------------------------------------
+const OverdrawMap& Menu::getOverdraw() const {
+    return overdraw;
+}
+
 //------------------------------------------------------------------------------
 VertContainer& Menu::getContainer() {
     return container;
@@ -177,23 +219,99 @@ bool Menu::removeInputHook(HookHandle& handle) {
 }
 
 //------------------------------------------------------------------------------
-void Menu::entryLoop() {
-    while (!exitMenu) {
-        conu::InputEvent input = console.getButtonInput();
-        hookChain.startHookChain(input);
-        if (input.type != inputEvent::Type::MOUSE_INPUT) {
-            continue;
-        }
+void Menu::setFocus(Box* box) {
+    Box* prevFocus = focusBox.get();
+    if (prevFocus == box) {
+        return;
+    }
+
+    focusBox = box != nullptr ? BoxHandle<Box>(*box) : BoxHandle<Box>();
+    if (prevFocus != nullptr) {
+        prevFocus->focusLost();
+    }
+}
+
+//------------------------------------------------------------------------------
+Box* Menu::getFocus() const {
+    return focusBox.get();
+}
 
-        Reply response = container.interact(input.info.mouse);
-        MenuReplyAction* action = actionFactory.getAction(response);
-        if (action == nullptr) {
-            continue;
+//------------------------------------------------------------------------------
+void Menu::onEnter() {
+    exitMenu = false;
+
+    prevScreenWidth = console.getWindowWidth();
+    prevScreenHeight = console.getWindowHeight();
+    resizeScreen();
+
+    if (options.printOnEnter) {
+        print();
+    }
+}
+
+//------------------------------------------------------------------------------
+void Menu::step() {
+    conu::InputEvent input = console.getButtonInput();
+    processInput(input);
+
+    // Refresh requests made while processing queued inputs are coalesced into
+    // a single print once no button input is left to process. Pending mouse
+    // movements do not hold the print back since getButtonInput() skips them
+    if (!exitMenu && !console.buttonInputPending()
+            && manager.takeRefreshRequest()) {
+        print();
+    }
+}
+
+//------------------------------------------------------------------------------
+void Menu::onExit() {
+    setFocus(nullptr);
+
+    console.waitForPresenter();
+    if (options.clearOnExit) {
+        console.clearScreen();
+    }
+    if (options.resizeScreen) {
+        console.setWindowDimensions(prevScreenWidth, prevScreenHeight);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool Menu::exiting() const {
+    return exitMenu;
+}
+
+//------------------------------------------------------------------------------
+void Menu::processInput(InputEvent& input) {
+    hookChain.startHookChain(input);
+
+    // The focused Box gets the first chance to handle the input. The focus is
+    // resolved on every input since the focused Box may have been destroyed
+    Box* focused = focusBox.get();
+    if (focused != nullptr) {
+        Reply response = focused->focusInput(input);
+        if (response != Reply::IGNORED) {
+            executeReply(response);
+            return;
         }
+    }
 
-        action->execute(*this);
-        delete action;
+    if (input.type != inputEvent::Type::MOUSE_INPUT) {
+        return;
+    }
+
+    executeReply(container.interact(input.info.mouse));
+}
+
+//------------------------------------------------------------------------------
+void Menu::executeReply(Reply response) {
+    MenuReplyAction* action = actionFactory.getAction(response);
+    if (action == nullptr) {
+        return;
     }
+
+    action->execute(*this);
+    delete action;
 }
 
 //------------------------------------------------------------------------------
@@ -211,4 +329,25 @@ void Menu::resizeScreen() {
     console.setWindowDimensions(screenWidth, screenHeight);
 }
 
+//------------------------------------------------------------------------------
+BoxArena* Menu::getArena() {
+    if (!options.useArena) {
+        return nullptr;
+    }
+
+    if (arena == nullptr) {
+        arena.reset(new BoxArena());
+    }
+    return arena.get();
+}
+
+//------------------------------------------------------------------------------
+void Menu::finishOverdraw(bool drawMode) {
+    console.setOverdrawTracking(false);
+    overdraw = console.getOverdraw();
+    if (options.showOverdraw) {
+        console.printOverdraw(drawMode);
+    }
+}
+
 }
\ No newline at end of file
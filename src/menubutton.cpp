@@ -57,9 +57,11 @@ Reply MenuButton::interact(inputEvent::MouseEvent action) {
         return Reply::IGNORED;
     }
 
-    // Execute click handler (if present) and enter Menu
-    if (clickHandler) {
-        clickHandler(*this);
+    // Execute click handler (if present) and enter Menu. The Menu is scheduled
+    // by the MenuManager if a Menu is already active. Actions that take the
+    // MouseEvent are not run.
+    if (clickHandler && !passInput) {
+        clickHandler(*this, action);
     }
     return entryMenu->enter();
 }
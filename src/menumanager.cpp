@@ -6,9 +6,12 @@
 // Description: The MenuManager object is responsible for automatically handling 
 //     auto printing on a per-Menu basis. Menus are inserted into the
 //     MenuManager in FILO behavior, where the most recently inserted Menu is
-//     the active Menu that is being managed for auto print. 
+//     the active Menu that is being managed for auto print. The MenuManager
+//     also runs the navigation scheduler, which operates the active Menu and
+//     switches between Menus within a single loop, and a TimerWheel of
+//     callbacks that are executed on the frame rate manager thread.
 // 
-// Dependencies: Menu class.
+// Dependencies: Menu and TimerWheel class.
 //------------------------------------------------------------------------------
 
 #include "Menu/menumanager.h"
@@ -28,9 +31,17 @@ MenuManager::MenuManager() :
     restoreConsoleOnEmpty{ false },
     menuStack{ },
     frameInterval{ std::chrono::milliseconds(0) },
+    refreshRequested{ false },
+    navActive{ false },
+    navDepth{ 0 },
+    navRequests{ },
+    transitionLatency{ std::chrono::microseconds(0) },
+    timerWheel{ },
+    timersChanged{ false },
     threadTargetState{ ManagerState::INACTIVE },
     threadCurrentState{ ManagerState::INACTIVE },
     managerLock{ },
+    updateLock{ },
     managerCV{ } {
 
 }
@@ -47,15 +58,21 @@ MenuManager& MenuManager::getInstance() {
 
 //------------------------------------------------------------------------------
 void MenuManager::pushMenu(Menu& inMenu) {
-    std::lock_guard<std::mutex> lock(stackLock);
+    stackLock.lock();
     menuStack.push(&inMenu);
+    stackLock.unlock();
+
+    // The Menu stack is released before update() waits on the frame rate
+    // manager, since timer callbacks on that thread may acquire the stack
     update();
 }
 
 //------------------------------------------------------------------------------
 void MenuManager::popMenu() {
-    std::lock_guard<std::mutex> lock(stackLock);
+    stackLock.lock();
     menuStack.pop();
+    stackLock.unlock();
+
     update();
 }
 
@@ -70,12 +87,22 @@ const Menu* MenuManager::peekMenu() {
 
 //------------------------------------------------------------------------------
 void MenuManager::update() {
-    if (menuStack.empty()) {
+    std::lock_guard<std::mutex> lock(updateLock);
+    stackLock.lock();
+    bool emptyStack = menuStack.empty();
+    MenuOptions currOptions;
+    if (!emptyStack) {
+        currOptions = menuStack.top()->getOptions();
+    }
+    stackLock.unlock();
+
+    if (emptyStack) {
         if (restoreConsoleOnEmpty) {
             
             restoreConsoleOnEmpty = false;
         }
         stopFrameRateManager();
+        console.stopPresenter();
         return;
     }
     if (threadCurrentState == ManagerState::INACTIVE) {
@@ -88,7 +115,6 @@ void MenuManager::update() {
         restoreConsoleOnEmpty = true;
     }
 
-    MenuOptions currOptions = menuStack.top()->getOptions();
     pauseFrameRateManager();
     if (!currOptions.useAutoPrint) {
         return;
@@ -138,49 +164,222 @@ void MenuManager::refreshMenu() {
     menuStack.top()->print();
 }
 
+//------------------------------------------------------------------------------
+void MenuManager::requestRefresh() {
+    refreshRequested = true;
+}
+
+//------------------------------------------------------------------------------
+bool MenuManager::takeRefreshRequest() {
+    return refreshRequested.exchange(false);
+}
+
+//------------------------------------------------------------------------------
+void MenuManager::setFocus(Box* box) {
+    std::lock_guard<std::mutex> lock(stackLock);
+    if (menuStack.empty()) {
+        return;
+    }
+
+    menuStack.top()->setFocus(box);
+}
+
+//------------------------------------------------------------------------------
+void MenuManager::releaseFocus(const Box* box) {
+    std::lock_guard<std::mutex> lock(stackLock);
+    if (menuStack.empty()) {
+        return;
+    }
+
+    if (menuStack.top()->getFocus() == box) {
+        menuStack.top()->setFocus(nullptr);
+    }
+}
+
+//------------------------------------------------------------------------------
+Reply MenuManager::navigate(Menu& root) {
+    // Only a single scheduler loop runs at a time. The loop clears navActive
+    // while holding navLock, so the root Menu cannot be pushed onto a loop
+    // that already ended
+    navLock.lock();
+    if (navActive) {
+        navRequests.push(NavRequest{ false, &root });
+        navLock.unlock();
+        return Reply::CONTINUE;
+    }
+    navActive = true;
+    navLock.unlock();
+    navDepth = 0;
+    enterMenu(root);
+
+    Reply rootReply = Reply::CONTINUE;
+    while (navDepth > 0) {
+        Menu* active = activeMenu();
+
+        // Apply pending navigation requests before operating the active Menu
+        NavRequest request{ false, nullptr };
+        navLock.lock();
+        if (!navRequests.empty()) {
+            request = navRequests.front();
+            navRequests.pop();
+        }
+        navLock.unlock();
+        if (request.menu != nullptr) {
+            std::chrono::steady_clock::time_point start
+                    = std::chrono::steady_clock::now();
+            if (request.replace) {
+                leaveMenu();
+            }
+            enterMenu(*request.menu);
+            transitionLatency = std::chrono::duration_cast<
+                    std::chrono::microseconds>(std::chrono::steady_clock::now()
+                    - start);
+            continue;
+        }
+
+        if (!active->exiting()) {
+            active->step();
+            continue;
+        }
+
+        // Exit the active Menu and pass its exit Reply to the parent Menu
+        std::chrono::steady_clock::time_point start
+                = std::chrono::steady_clock::now();
+        Reply reply = leaveMenu();
+        if (navDepth == 0) {
+            rootReply = reply;
+            break;
+        }
+        activeMenu()->executeReply(reply);
+        transitionLatency = std::chrono::duration_cast<
+                std::chrono::microseconds>(std::chrono::steady_clock::now()
+                - start);
+    }
+
+    // Discard requests made by the root Menu as it exited
+    std::lock_guard<std::mutex> lock(navLock);
+    navRequests = std::queue<NavRequest>();
+    navActive = false;
+    return rootReply;
+}
+
+//------------------------------------------------------------------------------
+bool MenuManager::navigating() const {
+    return navActive;
+}
+
+//------------------------------------------------------------------------------
+void MenuManager::pushNavigation(Menu& menu) {
+    std::lock_guard<std::mutex> lock(navLock);
+    if (!navActive) {
+        return;
+    }
+
+    navRequests.push(NavRequest{ false, &menu });
+}
+
+//------------------------------------------------------------------------------
+void MenuManager::replaceNavigation(Menu& menu) {
+    std::lock_guard<std::mutex> lock(navLock);
+    if (!navActive) {
+        return;
+    }
+
+    navRequests.push(NavRequest{ true, &menu });
+}
+
+//------------------------------------------------------------------------------
+void MenuManager::popNavigation() {
+    std::lock_guard<std::mutex> lock(stackLock);
+    if (menuStack.empty()) {
+        return;
+    }
+
+    menuStack.top()->exit();
+}
+
+//------------------------------------------------------------------------------
+std::chrono::microseconds MenuManager::getTransitionLatency() const {
+    return transitionLatency;
+}
+
+//------------------------------------------------------------------------------
+TimerHandle MenuManager::addTimer(std::chrono::milliseconds delay,
+        std::function<void()> callback) {
+    return scheduleTimer(delay, std::chrono::milliseconds(0), callback);
+}
+
+//------------------------------------------------------------------------------
+TimerHandle MenuManager::addRepeatingTimer(std::chrono::milliseconds interval,
+        std::function<void()> callback) {
+    static const std::chrono::milliseconds MINIMUM_INTERVAL(1);
+    if (interval < MINIMUM_INTERVAL) {
+        interval = MINIMUM_INTERVAL;
+    }
+
+    return scheduleTimer(interval, interval, callback);
+}
+
+//------------------------------------------------------------------------------
+bool MenuManager::removeTimer(TimerHandle& handle) {
+    std::lock_guard<std::mutex> lock(timerLock);
+    return timerWheel.removeTimer(handle);
+}
 
 //------------------------------------------------------------------------------
 void MenuManager::frameRateManager() {
-    threadCurrentState = ManagerState::ACTIVE;
-    std::chrono::milliseconds prevPrintTime = getTimeMS();
-    std::chrono::milliseconds prevFrameTime = getTimeMS();
-    std::chrono::milliseconds currTime;
+    typedef TimerWheel::Clock Clock;
+    Clock::time_point prevPrintTime = Clock::now();
+    Clock::time_point prevFrameTime = prevPrintTime;
+    std::vector<std::function<void()>> expired;
+    bool printPending = false;
     int frameCount = 0;
 
     // prevPrintTime is used to mark the time point of the previous print()
     // prevFrameTime is used to mark the time point when frameCount is uploaded
     //     to realtimeFrameRate
+    // printPending is used to mark that a print() could not acquire the Menu
+    //     stack and must be retried
 
     realtimeFrameRate = -1;
     while (true) {
-        // Check for state changes
-        // State change check inverted to reduce checks per loop iteration
-        if (threadTargetState != ManagerState::ACTIVE) {
-            // INACTIVE state
-            if (threadTargetState == ManagerState::INACTIVE) {
-                threadCurrentState = ManagerState::INACTIVE;
-                realtimeFrameRate = -1;
-                return;
-            }
-            if (threadTargetState == ManagerState::PAUSED) {
-                threadCurrentState = ManagerState::PAUSED;
-
-                std::unique_lock<std::mutex> lock(managerLock);
-                managerCV.wait(lock);
-
-                threadCurrentState = ManagerState::ACTIVE;
+        // Confirm state changes
+        ManagerState targetState = threadTargetState;
+        if (targetState == ManagerState::INACTIVE) {
+            threadCurrentState = ManagerState::INACTIVE;
+            realtimeFrameRate = -1;
+            return;
+        }
+        threadCurrentState = targetState;
+        bool autoPrinting = targetState == ManagerState::ACTIVE;
+
+        // Execute all expired timers as a single batch
+        Clock::time_point currTime = Clock::now();
+        timerLock.lock();
+        timerWheel.collectExpired(currTime, expired);
+        timerLock.unlock();
+        if (!expired.empty()) {
+            for (std::function<void()>& callback : expired) {
+                callback();
             }
+            expired.clear();
+            printPending = true;
         }
 
         // Check if need to draw frame
-        currTime = getTimeMS();
-        if (currTime - prevPrintTime >= frameInterval && stackLock.try_lock()) {
-            menuStack.top()->print();
+        if (autoPrinting && currTime - prevPrintTime >= frameInterval) {
+            printPending = true;
+        }
+        if (printPending && stackLock.try_lock()) {
+            if (!menuStack.empty()) {
+                menuStack.top()->print();
+            }
+            stackLock.unlock();
+            printPending = false;
             prevPrintTime = currTime;
             ++frameCount;
-            stackLock.unlock();
         }
-        
+
         // Check if need to update realtime frame rate
         static const auto SECOND = std::chrono::seconds(1);
         if (currTime - prevFrameTime >= SECOND) {
@@ -189,13 +388,85 @@ void MenuManager::frameRateManager() {
             frameCount = 0;
         }
 
+        // Sleep until the next frame or timer is due. The thread is also woken
+        // on state changes and added timers.
+        static const auto RETRY_INTERVAL = std::chrono::milliseconds(1);
+        bool wakeScheduled = false;
+        Clock::time_point wakeTime;
+        if (printPending) {
+            wakeTime = currTime + RETRY_INTERVAL;
+            wakeScheduled = true;
+        }
+        else if (autoPrinting) {
+            wakeTime = prevPrintTime + frameInterval;
+            wakeScheduled = true;
+        }
+
+        Clock::time_point timerDue;
+        timerLock.lock();
+        if (timerWheel.nextDue(timerDue)
+                && (!wakeScheduled || timerDue < wakeTime)) {
+            wakeTime = timerDue;
+            wakeScheduled = true;
+        }
+        timerLock.unlock();
+
+        std::unique_lock<std::mutex> lock(managerLock);
+        if (threadTargetState != targetState || timersChanged) {
+            timersChanged = false;
+            continue;
+        }
+        if (wakeScheduled) {
+            managerCV.wait_until(lock, wakeTime);
+        }
+        else {
+            managerCV.wait(lock);
+        }
+        timersChanged = false;
     }
 }
 
 //------------------------------------------------------------------------------
-std::chrono::milliseconds MenuManager::getTimeMS() const {
-    return std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch());
+TimerHandle MenuManager::scheduleTimer(std::chrono::milliseconds delay,
+        std::chrono::milliseconds interval, std::function<void()> callback) {
+    TimerHandle handle;
+    timerLock.lock();
+    handle = timerWheel.addTimer(TimerWheel::Clock::now() + delay, interval,
+            callback);
+    timerLock.unlock();
+
+    std::lock_guard<std::mutex> lock(managerLock);
+    timersChanged = true;
+    managerCV.notify_one();
+    return handle;
+}
+
+//------------------------------------------------------------------------------
+void MenuManager::wakeFrameRateManager() {
+    std::lock_guard<std::mutex> lock(managerLock);
+    managerCV.notify_one();
+}
+
+//------------------------------------------------------------------------------
+Menu* MenuManager::activeMenu() {
+    std::lock_guard<std::mutex> lock(stackLock);
+    return menuStack.top();
+}
+
+//------------------------------------------------------------------------------
+void MenuManager::enterMenu(Menu& menu) {
+    pushMenu(menu);
+    ++navDepth;
+    menu.onEnter();
+}
+
+//------------------------------------------------------------------------------
+Reply MenuManager::leaveMenu() {
+    Menu* menu = activeMenu();
+    menu->onExit();
+    popMenu();
+    --navDepth;
+    return menu->exitReply;
 }
 
 //------------------------------------------------------------------------------
@@ -221,6 +492,7 @@ void MenuManager::stopFrameRateManager() {
 
     resumeFrameRateManager();
     threadTargetState = ManagerState::INACTIVE;
+    wakeFrameRateManager();
     frameRateManagerThread.join();
 }
 
@@ -231,6 +503,7 @@ void MenuManager::pauseFrameRateManager() {
     }
 
     threadTargetState = ManagerState::PAUSED;
+    wakeFrameRateManager();
 
     // Block until thread state change confirmed
     while (threadCurrentState != threadTargetState) {
@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+// overdrawmap.cpp
+// Implementation for the OverdrawMap class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: An OverdrawMap is a diagnostic grid that records how many times
+//     each cell of the console window was written to during a frame, along
+//     with the name of the writer that wrote each cell last. The map can be
+//     rendered as a heatmap of single character write counts or dumped as a
+//     text grid. An OverdrawMap is not thread safe and must be externally
+//     synchronized.
+//
+// Dependencies: InputEvent struct.
+//------------------------------------------------------------------------------
+
+#include "ConsoleEditor/overdrawmap.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+// Static member initialization
+const int OverdrawMap::NO_WRITER;
+const char OverdrawMap::WRITER_KEYS[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+//------------------------------------------------------------------------------
+OverdrawMap::OverdrawMap() :
+    width{ 0 },
+    height{ 0 } {
+
+}
+
+//------------------------------------------------------------------------------
+void OverdrawMap::reset(int width, int height) {
+    this->width = width < 0 ? 0 : width;
+    this->height = height < 0 ? 0 : height;
+    writes.assign(this->width * this->height, 0);
+    lastWriters.assign(this->width * this->height, NO_WRITER);
+}
+
+//------------------------------------------------------------------------------
+int OverdrawMap::internWriter(const std::string& name) {
+    auto it = writerIds.find(name);
+    if (it != writerIds.end()) {
+        return it->second;
+    }
+
+    int id = static_cast<int>(writerNames.size());
+    writerNames.push_back(name);
+    writerIds[name] = id;
+    return id;
+}
+
+//------------------------------------------------------------------------------
+void OverdrawMap::record(const Position& pos, int length, int writer) {
+    if (pos.row < 0 || pos.row >= height) {
+        return;
+    }
+
+    int startCol = pos.col < 0 ? 0 : pos.col;
+    int endCol = pos.col + length > width ? width : pos.col + length;
+    int rowStart = pos.row * width;
+    for (int col = startCol; col < endCol; ++col) {
+        ++writes[rowStart + col];
+        lastWriters[rowStart + col] = writer;
+    }
+}
+
+//------------------------------------------------------------------------------
+int OverdrawMap::getWidth() const {
+    return width;
+}
+
+//------------------------------------------------------------------------------
+int OverdrawMap::getHeight() const {
+    return height;
+}
+
+//------------------------------------------------------------------------------
+int OverdrawMap::getWrites(const Position& pos) const {
+    if (pos.col < 0 || pos.col >= width || pos.row < 0 || pos.row >= height) {
+        return 0;
+    }
+
+    return writes[pos.row * width + pos.col];
+}
+
+//------------------------------------------------------------------------------
+std::string OverdrawMap::getWriter(const Position& pos) const {
+    if (pos.col < 0 || pos.col >= width || pos.row < 0 || pos.row >= height) {
+        return std::string();
+    }
+
+    int writer = lastWriters[pos.row * width + pos.col];
+    if (writer == NO_WRITER) {
+        return std::string();
+    }
+    return writerNames[writer];
+}
+
+//------------------------------------------------------------------------------
+int OverdrawMap::getMaxWrites() const {
+    int maxWrites = 0;
+    for (int cellWrites : writes) {
+        if (cellWrites > maxWrites) {
+            maxWrites = cellWrites;
+        }
+    }
+    return maxWrites;
+}
+
+//------------------------------------------------------------------------------
+std::string OverdrawMap::getHeatRow(int row) const {
+    if (row < 0 || row >= height) {
+        return std::string();
+    }
+
+    std::string heatRow(width, ' ');
+    for (int col = 0; col < width; ++col) {
+        int cellWrites = writes[row * width + col];
+        if (cellWrites > 9) {
+            heatRow[col] = '+';
+        }
+        else if (cellWrites > 0) {
+            heatRow[col] = static_cast<char>('0' + cellWrites);
+        }
+    }
+    return heatRow;
+}
+
+//------------------------------------------------------------------------------
+std::string OverdrawMap::dump() const {
+    std::string text;
+    for (int row = 0; row < height; ++row) {
+        text += getHeatRow(row);
+        text += '\n';
+    }
+    text += '\n';
+
+    // Writers past the available keys share the last key
+    const int keyCount = static_cast<int>(sizeof(WRITER_KEYS)) - 1;
+    std::vector<bool> usedWriters(writerNames.size(), false);
+    for (int row = 0; row < height; ++row) {
+        for (int col = 0; col < width; ++col) {
+            int writer = lastWriters[row * width + col];
+            if (writer == NO_WRITER) {
+                text += ' ';
+                continue;
+            }
+
+            usedWriters[writer] = true;
+            text += WRITER_KEYS[writer < keyCount ? writer : keyCount - 1];
+        }
+        text += '\n';
+    }
+    text += '\n';
+
+    for (std::size_t i = 0; i < writerNames.size(); ++i) {
+        if (!usedWriters[i]) {
+            continue;
+        }
+
+        int key = static_cast<int>(i) < keyCount ? i : keyCount - 1;
+        text += WRITER_KEYS[key];
+        text += " = ";
+        text += writerNames[i];
+        text += '\n';
+    }
+    return text;
+}
+
+}
\ No newline at end of file
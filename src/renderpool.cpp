@@ -0,0 +1,183 @@
+//------------------------------------------------------------------------------
+// renderpool.cpp
+// Implementation for the RenderPool class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: The RenderPool is a small pool of worker threads used by
+//     BoxContainers to buffer independent contained Boxes in parallel. A batch
+//     of jobs is submitted through run(), which blocks until every job in the
+//     batch has completed. The submitting thread executes jobs alongside the
+//     workers. Jobs that submit a batch of their own are executed serially to
+//     prevent the pool from waiting on itself. This class is implemented as a
+//     singleton; an instance must be aquired through the
+//     RenderPool::getInstance() method.
+// 
+// Dependencies: None.
+//------------------------------------------------------------------------------
+
+#include "Box/BoxContainer/renderpool.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+// Static member initialization
+RenderPool RenderPool::instance;
+thread_local bool RenderPool::workerThread = false;
+
+//------------------------------------------------------------------------------
+RenderPool::RenderPool() :
+    workers{ },
+    threadCount{ 1 },
+    terminateWorkers{ false },
+    batch{ nullptr },
+    batchId{ 0 },
+    nextJob{ 0 },
+    remainingJobs{ 0 },
+    activeWorkers{ 0 } {
+
+    // Batches run serially until a thread count is set, since handing small
+    // Boxes off to workers measured slower than buffering them on a single
+    // thread (see examples/benchmarks/parallelbuffer.cpp)
+}
+
+//------------------------------------------------------------------------------
+RenderPool::~RenderPool() {
+    stopWorkers();
+}
+
+//------------------------------------------------------------------------------
+RenderPool& RenderPool::getInstance() {
+    return instance;
+}
+
+//------------------------------------------------------------------------------
+void RenderPool::setThreadCount(int count) {
+    std::lock_guard<std::mutex> lock(runLock);
+    if (count < 1) {
+        count = 1;
+    }
+
+    // Workers are relaunched lazily by the next run()
+    stopWorkers();
+    threadCount = count;
+}
+
+//------------------------------------------------------------------------------
+int RenderPool::getThreadCount() const {
+    return threadCount;
+}
+
+//------------------------------------------------------------------------------
+void RenderPool::run(const std::vector<std::function<void()>>& jobs) {
+    // Execute serially if there is nothing to gain or if called from a job
+    if (threadCount <= 1 || jobs.size() <= 1 || workerThread) {
+        for (const std::function<void()>& job : jobs) {
+            job();
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> runGuard(runLock);
+    if (workers.empty()) {
+        startWorkers();
+    }
+
+    // Open the batch to the workers
+    std::unique_lock<std::mutex> lock(poolLock);
+    batch = &jobs;
+    nextJob = 0;
+    remainingJobs = static_cast<unsigned>(jobs.size());
+    ++batchId;
+    lock.unlock();
+    batchCV.notify_all();
+
+    workerThread = true;
+    executeJobs(jobs);
+    workerThread = false;
+
+    // Wait for the workers to finish their claimed jobs, then close the batch
+    lock.lock();
+    doneCV.wait(lock, [this]() {
+            return remainingJobs == 0 && activeWorkers == 0;
+        });
+    batch = nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool RenderPool::onWorkerThread() {
+    return workerThread;
+}
+
+//------------------------------------------------------------------------------
+void RenderPool::worker() {
+    workerThread = true;
+    unsigned seenBatch = 0;
+
+    std::unique_lock<std::mutex> lock(poolLock);
+    while (true) {
+        batchCV.wait(lock, [this, &seenBatch]() {
+                return terminateWorkers || batchId != seenBatch;
+            });
+        if (terminateWorkers) {
+            return;
+        }
+
+        // Skip batches that were closed before this worker woke up
+        seenBatch = batchId;
+        if (batch == nullptr) {
+            continue;
+        }
+
+        const std::vector<std::function<void()>>* currBatch = batch;
+        ++activeWorkers;
+        lock.unlock();
+
+        executeJobs(*currBatch);
+
+        lock.lock();
+        --activeWorkers;
+        doneCV.notify_all();
+    }
+}
+
+//------------------------------------------------------------------------------
+void RenderPool::executeJobs(const std::vector<std::function<void()>>& jobs) {
+    unsigned jobCount = static_cast<unsigned>(jobs.size());
+    unsigned idx;
+
+    while ((idx = nextJob.fetch_add(1)) < jobCount) {
+        jobs[idx]();
+
+        // Last job of the batch notifies the submitting thread. poolLock is
+        // taken so the notification cannot slip past the waiting thread.
+        if (remainingJobs.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(poolLock);
+            doneCV.notify_all();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void RenderPool::startWorkers() {
+    terminateWorkers = false;
+
+    // The submitting thread counts towards the thread count
+    for (int i = 1; i < threadCount; ++i) {
+        workers.push_back(std::thread(&RenderPool::worker, this));
+    }
+}
+
+//------------------------------------------------------------------------------
+void RenderPool::stopWorkers() {
+    std::unique_lock<std::mutex> lock(poolLock);
+    terminateWorkers = true;
+    lock.unlock();
+    batchCV.notify_all();
+
+    for (std::thread& currWorker : workers) {
+        currWorker.join();
+    }
+    workers.clear();
+}
+
+}
@@ -51,6 +51,7 @@ Reply ScrollingTextBox::interact(inputEvent::MouseEvent action) {
         return Reply::IGNORED;
     }
 
+    invalidateSurface();
     return Reply::REFRESH;
 }
 
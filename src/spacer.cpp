@@ -19,12 +19,14 @@ namespace conu {
 Spacer::Spacer() :
     ContentBox() {
 
+    opaqueBase = true;
 }
 
 //------------------------------------------------------------------------------
 Spacer::Spacer(int width, int height) :
     ContentBox(width, height) {
 
+    opaqueBase = true;
 }
 
 //------------------------------------------------------------------------------
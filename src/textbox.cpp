@@ -7,9 +7,10 @@
 //     text that is printed within the dimensions of the TextBox to the console
 //     window. The text content is aligned within the TextBox depending on the
 //     alignment flags specified. Does not produce any output or action upon
-//     interaction.
+//     interaction. The text is shared between copies of a TextBox until one
+//     of the copies changes its text.
 // 
-// Dependencies: ContentBox class.
+// Dependencies: ContentBox class and SharedValue class.
 //------------------------------------------------------------------------------
 
 #include "Box/ContentBox/TextBox/textbox.h"
@@ -21,6 +22,7 @@ TextBox::TextBox(std::string text) :
     ContentBox(),
     text{ text } {
 
+    opaqueBase = true;
 }
 
 //------------------------------------------------------------------------------
@@ -28,6 +30,7 @@ TextBox::TextBox(int width, int height, std::string text) :
     ContentBox(width, height),
     text{ text } {
 
+    opaqueBase = true;
 }
 
 //------------------------------------------------------------------------------
@@ -53,6 +56,7 @@ std::string TextBox::getClassName() const {
 //------------------------------------------------------------------------------
 void TextBox::setText(std::string text) {
     this->text = text;
+    invalidateSurface();
 }
 
 //------------------------------------------------------------------------------
@@ -95,6 +99,7 @@ Reply TextBox::printProtocol(Position pos, Boundary container, bool drawMode) {
 
 //------------------------------------------------------------------------------
 void TextBox::splitText() {
+    const std::string& text = this->text.get();
     int startIdx = 0;
     int endIdx = 0;
     lines.clear();
@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+// timerwheel.cpp
+// Implementation for the TimerWheel class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: A TimerWheel is a hashed timing wheel that stores one-shot and
+//     repeating timer callbacks. Timers are hashed into a fixed ring of slots
+//     by the millisecond tick they are due, so adding, removing, and expiring
+//     a timer does not depend on the amount of stored timers. Expired timer
+//     callbacks are collected in batches to be executed by the caller.
+//     A TimerWheel is not thread safe and must be externally synchronized.
+//
+// Dependencies: None.
+//------------------------------------------------------------------------------
+
+#include "Menu/timerwheel.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+TimerHandle::TimerHandle() :
+    timerId{ 0 } {
+
+}
+
+//------------------------------------------------------------------------------
+TimerHandle::TimerHandle(unsigned inId) :
+    timerId{ inId } {
+
+}
+
+//------------------------------------------------------------------------------
+TimerWheel::TimerWheel() :
+    origin{ Clock::now() },
+    currTick{ 0 },
+    timers{ },
+    slots(SLOT_COUNT),
+    nextId{ 1 } {
+
+}
+
+//------------------------------------------------------------------------------
+TimerHandle TimerWheel::addTimer(Clock::time_point due,
+        std::chrono::milliseconds interval, std::function<void()> callback) {
+    // Round the due time up so that a timer is never expired early
+    long long dueTick = toTick(due, true);
+    if (dueTick < currTick) {
+        dueTick = currTick;
+    }
+
+    unsigned id = nextId++;
+    if (nextId == 0) {
+        nextId = 1;
+    }
+
+    long long intervalTicks = interval.count() > 0 ? interval.count() : 0;
+    timers[id] = Timer{ dueTick, intervalTicks, callback };
+    insertIntoSlot(id, dueTick);
+    return TimerHandle(id);
+}
+
+//------------------------------------------------------------------------------
+bool TimerWheel::removeTimer(TimerHandle& handle) {
+    // Ids left in the slots are discarded when the slot is next expired
+    if (handle.timerId == 0 || timers.erase(handle.timerId) == 0) {
+        return false;
+    }
+
+    handle.timerId = 0;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+int TimerWheel::collectExpired(Clock::time_point now,
+        std::vector<std::function<void()>>& expired) {
+    long long nowTick = toTick(now, false);
+    if (nowTick < currTick) {
+        return 0;
+    }
+
+    std::size_t prevSize = expired.size();
+    if (timers.empty()) {
+        currTick = nowTick + 1;
+        return 0;
+    }
+
+    // Visit each slot at most once, even if more than a full revolution of
+    // the wheel has passed
+    long long lastTick = nowTick;
+    if (nowTick - currTick >= SLOT_COUNT) {
+        lastTick = currTick + SLOT_COUNT - 1;
+    }
+
+    std::vector<unsigned> rescheduled;
+    for (long long tick = currTick; tick <= lastTick; ++tick) {
+        int slot = static_cast<int>(tick % SLOT_COUNT);
+        std::vector<unsigned> remaining;
+        for (unsigned id : slots[slot]) {
+            auto it = timers.find(id);
+            if (it == timers.end()) {
+                continue;
+            }
+            if (it->second.dueTick > nowTick) {
+                remaining.push_back(id);
+                continue;
+            }
+
+            expired.push_back(it->second.callback);
+            if (it->second.intervalTicks == 0) {
+                timers.erase(it);
+                continue;
+            }
+
+            // Skip any intervals that were missed entirely
+            long long missed = (nowTick - it->second.dueTick)
+                    / it->second.intervalTicks + 1;
+            it->second.dueTick += missed * it->second.intervalTicks;
+            rescheduled.push_back(id);
+        }
+        slots[slot].swap(remaining);
+    }
+    currTick = nowTick + 1;
+
+    for (unsigned id : rescheduled) {
+        insertIntoSlot(id, timers[id].dueTick);
+    }
+    return static_cast<int>(expired.size() - prevSize);
+}
+
+//------------------------------------------------------------------------------
+bool TimerWheel::nextDue(Clock::time_point& due) const {
+    if (timers.empty()) {
+        return false;
+    }
+
+    // Search one revolution of the wheel for the nearest due timer
+    long long dueTick = -1;
+    for (long long tick = currTick; tick < currTick + SLOT_COUNT
+            && dueTick < 0; ++tick) {
+        for (unsigned id : slots[static_cast<int>(tick % SLOT_COUNT)]) {
+            auto it = timers.find(id);
+            if (it != timers.end() && it->second.dueTick <= tick) {
+                dueTick = it->second.dueTick;
+                break;
+            }
+        }
+    }
+
+    // All timers are due after a full revolution; search every timer
+    if (dueTick < 0) {
+        for (const auto& timer : timers) {
+            if (dueTick < 0 || timer.second.dueTick < dueTick) {
+                dueTick = timer.second.dueTick;
+            }
+        }
+    }
+
+    due = origin + std::chrono::milliseconds(dueTick);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool TimerWheel::empty() const {
+    return timers.empty();
+}
+
+//------------------------------------------------------------------------------
+void TimerWheel::clear() {
+    timers.clear();
+    for (std::vector<unsigned>& slot : slots) {
+        slot.clear();
+    }
+}
+
+//------------------------------------------------------------------------------
+long long TimerWheel::toTick(Clock::time_point time, bool roundUp) const {
+    long long elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            time - origin).count();
+    if (elapsed < 0) {
+        return 0;
+    }
+
+    const long long MICRO_IN_TICK = 1000;
+    long long tick = elapsed / MICRO_IN_TICK;
+    if (roundUp && elapsed % MICRO_IN_TICK != 0) {
+        ++tick;
+    }
+    return tick;
+}
+
+//------------------------------------------------------------------------------
+void TimerWheel::insertIntoSlot(unsigned id, long long tick) {
+    slots[static_cast<int>(tick % SLOT_COUNT)].push_back(id);
+}
+
+}
\ No newline at end of file
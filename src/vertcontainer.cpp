@@ -33,16 +33,19 @@ VertContainer::VertContainer(
     const VertContainer& cpy) :
     BoxContainer(cpy) {
 
-    for (auto it = cpy.contents.begin(); it != cpy.contents.end(); ++it) {
-        this->contents[it->first].item = it->second.item->copyBox();
-    }
+}
+
+//------------------------------------------------------------------------------
+VertContainer::VertContainer(VertContainer&& move) :
+    BoxContainer(std::move(move)) {
+
 }
 
 //------------------------------------------------------------------------------
 Reply VertContainer::interact(inputEvent::MouseEvent action) {
     for (auto it = contents.begin(); it != contents.end(); ++it) {
-        if (it->second.item->posInBounds(action.mousePosition)) {
-            return it->second.item->interact(action);
+        if (it->item->posInBounds(action.mousePosition)) {
+            return it->item->interact(action);
         }
     }
 
@@ -68,8 +71,8 @@ std::string VertContainer::getClassName() const {
 int VertContainer::getContentHeight() const {
     int maxHeight = 0;
     for (auto it = contents.begin(); it != contents.end(); ++it) {
-        //maxHeight = std::max<int>(maxHeight, it->second.item->getHeight());
-        maxHeight += it->second.item->getHeight();
+        //maxHeight = std::max<int>(maxHeight, it->item->getHeight());
+        maxHeight += it->item->getHeight();
     }
     maxHeight += horizBorderSize * 2;
 
@@ -80,8 +83,8 @@ int VertContainer::getContentHeight() const {
 int VertContainer::getContentWidth() const {
     int maxWidth = 0;
     for (auto it = contents.begin(); it != contents.end(); ++it) {
-        //maxWidth += it->second.item->getWidth();
-        maxWidth = std::max<int>(maxWidth, it->second.item->getWidth());
+        //maxWidth += it->item->getWidth();
+        maxWidth = std::max<int>(maxWidth, it->item->getWidth());
     }
     maxWidth += vertBorderSize * 2;
 
@@ -91,68 +94,66 @@ int VertContainer::getContentWidth() const {
 //------------------------------------------------------------------------------
 Reply VertContainer::printProtocol(Position pos, Boundary container,
         bool drawMode) {
-    // Get acutal dimensions and print base
+    // Get acutal dimensions
     int prevTargWidth = targetWidth;
     int prevTargHeight = targetHeight;
     targetWidth = getWidth();
     targetHeight = getHeight();
-    printBase(pos, container, drawMode);
+    calculateActualDimAndPos(pos, container);
     targetWidth = prevTargWidth;
     targetHeight = prevTargHeight;
 
     // Check if there is anything to print
     if (contents.empty()) {
+        paintBase(drawMode, nullptr);
         return Reply::CONTINUE;
     }
 
+    // Arrange contents, then print the base and the visible contents
+    layout(pos);
+    printContents(drawMode);
+
+    drawn = true;
+    return Reply::CONTINUE;
+}
+
+//------------------------------------------------------------------------------
+void VertContainer::arrangeContents(const Position& pos,
+        const Boundary& contentBound) {
     // Get total content height
     int totalHeight = 0;
     int dynamCount = 0;
     for (auto it = contents.begin(); it != contents.end(); ++it) {
-        if (!it->second.fixed) {
-            totalHeight += it->second.item->getHeight();
+        if (!it->fixed) {
+            totalHeight += it->item->getHeight();
             ++dynamCount;
         }
     }
 
-    // Get content space boundary and width spacing
-    Boundary contentBound = getContentBound(absolutePos);
+    // Get content spacing
     std::vector<int> spacing = getSpacingHeight(contentBound, totalHeight,
         dynamCount);
 
-    // Print contents
+    // Get the print position of each content Box
+    arrangement.reserve(contents.size());
     int spacingIdx = spacing.size() - 1;
     Position offset{ 0, actualHeight - horizBorderSize - 0 }; // TODO: test the - 1
     for (auto it = contents.rbegin(); it != contents.rend(); ++it) {
-        if (it->second.fixed) {
-            Position drawPos{ it->second.pos.col + pos.col, it->second.pos.row
+        if (it->fixed) {
+            Position drawPos{ it->pos.col + pos.col, it->pos.row
                     + pos.row };
-
-            if (drawMode) {
-                it->second.item->draw(drawPos, contentBound);
-            }
-            else {
-                it->second.item->buffer(drawPos, contentBound);
-            }
+            arrangement.push_back(ItemPlacement{ it->item, drawPos });
         }
         else {
-            int itemHeight = it->second.item->getHeight();
+            int itemHeight = it->item->getHeight();
             offset.row -= spacing[spacingIdx--] + itemHeight + 0; // TODO: test the + 1
-            offset.col = getColOffset(it->second.item->getWidth());
-
-            if (drawMode) {
-                it->second.item->draw(Position{ absolutePos.col + offset.col,
-                        absolutePos.row + offset.row }, contentBound);
-            }
-            else {
-                it->second.item->buffer(Position{ absolutePos.col + offset.col,
-                        absolutePos.row + offset.row }, contentBound);
-            }
+            offset.col = getColOffset(it->item->getWidth());
+
+            arrangement.push_back(ItemPlacement{ it->item,
+                    Position{ absolutePos.col + offset.col,
+                    absolutePos.row + offset.row } });
         }
     }
-
-    drawn = true;
-    return Reply::CONTINUE;
 }
 
 //------------------------------------------------------------------------------
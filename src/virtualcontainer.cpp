@@ -0,0 +1,290 @@
+//------------------------------------------------------------------------------
+// virtualcontainer.cpp
+// Implementation for the VirtualContainer class
+// Author: CONU contributors
+//------------------------------------------------------------------------------
+// Description: A VirtualContainer is a type of Box that displays a vertical
+//     list of a large amount of items. Instead of containing a Box for every
+//     item, the VirtualContainer only materializes a pool of row Boxes for the
+//     rows that are visible within its boundary. Row Boxes are copies of a
+//     user-defined row template and are recycled as the list is scrolled; a
+//     user-defined binder routine applies the data of an item to a row Box
+//     whenever the row is assigned a new item. The list can be scrolled using
+//     the mouse wheel.
+//
+// Dependencies: Box class.
+//------------------------------------------------------------------------------
+
+#include "Box/BoxContainer/virtualcontainer.h"
+
+namespace conu {
+
+//------------------------------------------------------------------------------
+VirtualContainer::VirtualContainer() :
+    Box(),
+    itemCount{ 0 },
+    rowHeight{ 1 },
+    scrollPos{ 0 },
+    rowWidth{ -1 },
+    visibleRows{ 0 },
+    rowTemplate{ nullptr } {
+
+}
+
+//------------------------------------------------------------------------------
+VirtualContainer::VirtualContainer(int width, int height) :
+    Box(width, height),
+    itemCount{ 0 },
+    rowHeight{ 1 },
+    scrollPos{ 0 },
+    rowWidth{ -1 },
+    visibleRows{ 0 },
+    rowTemplate{ nullptr } {
+
+}
+
+//------------------------------------------------------------------------------
+VirtualContainer::VirtualContainer(const VirtualContainer& copy) :
+    Box(copy),
+    itemCount{ copy.itemCount },
+    rowHeight{ copy.rowHeight },
+    scrollPos{ copy.scrollPos },
+    rowWidth{ -1 },
+    visibleRows{ 0 },
+    rowTemplate{ nullptr },
+    rowBinder{ copy.rowBinder } {
+
+    if (copy.rowTemplate != nullptr) {
+        rowTemplate = copy.rowTemplate->copyBox();
+    }
+}
+
+//------------------------------------------------------------------------------
+VirtualContainer::~VirtualContainer() {
+    clearRowPool();
+    delete rowTemplate;
+}
+
+//------------------------------------------------------------------------------
+Reply VirtualContainer::interact(inputEvent::MouseEvent action) {
+    // Make sure VirtualContainer has already been drawn
+    if (!drawn) {
+        return Reply::FAILED;
+    }
+
+    // Make sure input is within the VirtualContainer boundary
+    if (!posInBounds(action.mousePosition)) {
+        return Reply::IGNORED;
+    }
+
+    if (action.eventFlag == inputEvent::Mouse::WHEELED_BACKWARD
+            || action.eventFlag == inputEvent::Mouse::WHEELED_FORWARD) {
+        int prevScrollPos = scrollPos;
+        if (action.eventFlag == inputEvent::Mouse::WHEELED_BACKWARD) {
+            setScrollPosition(scrollPos + 1);
+        }
+        else {
+            setScrollPosition(scrollPos - 1);
+        }
+
+        return scrollPos == prevScrollPos ? Reply::CONTINUE : Reply::REFRESH;
+    }
+
+    // Send the input to the printed row under the mouse
+    for (Box* row : printedRows) {
+        if (row->posInBounds(action.mousePosition)) {
+            return row->interact(action);
+        }
+    }
+
+    return Reply::IGNORED;
+}
+
+//------------------------------------------------------------------------------
+Box* VirtualContainer::copyBox() const {
+    return new VirtualContainer(*this);
+}
+
+//------------------------------------------------------------------------------
+Box* VirtualContainer::createBox() const {
+    return new VirtualContainer();
+}
+
+//------------------------------------------------------------------------------
+std::string VirtualContainer::getClassName() const {
+    return std::string("VirtualContainer");
+}
+
+//------------------------------------------------------------------------------
+int VirtualContainer::getHeight() const {
+    return targetHeight;
+}
+
+//------------------------------------------------------------------------------
+int VirtualContainer::getWidth() const {
+    return targetWidth;
+}
+
+//------------------------------------------------------------------------------
+void VirtualContainer::setItemCount(int count) {
+    itemCount = count < 0 ? 0 : count;
+    rebindRows();
+}
+
+//------------------------------------------------------------------------------
+int VirtualContainer::getItemCount() const {
+    return itemCount;
+}
+
+//------------------------------------------------------------------------------
+void VirtualContainer::setRowHeight(int height) {
+    rowHeight = height < 1 ? 1 : height;
+
+    // Rows are resized on the next print
+    rowWidth = -1;
+    rebindRows();
+}
+
+//------------------------------------------------------------------------------
+void VirtualContainer::setRowTemplate(const Box& rowTemplate) {
+    delete this->rowTemplate;
+    this->rowTemplate = rowTemplate.copyBox();
+    clearRowPool();
+    invalidateSurface();
+}
+
+//------------------------------------------------------------------------------
+void VirtualContainer::setRowBinder(std::function<void(Box&, int)> binder) {
+    rowBinder = binder;
+    rebindRows();
+}
+
+//------------------------------------------------------------------------------
+void VirtualContainer::rebindRows() {
+    for (int& item : boundItems) {
+        item = -1;
+    }
+    invalidateSurface();
+}
+
+//------------------------------------------------------------------------------
+void VirtualContainer::setScrollPosition(int item) {
+    int maxScrollPos = getMaxScrollPosition();
+    if (item > maxScrollPos) {
+        item = maxScrollPos;
+    }
+    if (item < 0) {
+        item = 0;
+    }
+
+    if (scrollPos != item) {
+        scrollPos = item;
+        invalidateSurface();
+    }
+}
+
+//------------------------------------------------------------------------------
+int VirtualContainer::getScrollPosition() const {
+    return scrollPos;
+}
+
+//------------------------------------------------------------------------------
+Reply VirtualContainer::printProtocol(Position pos, Boundary container,
+        bool drawMode) {
+    printBase(pos, container, drawMode);
+
+    // Get the content boundary and the amount of rows that fit within it
+    Boundary contentBound{ absolutePos.col + vertBorderSize,
+            absolutePos.row + horizBorderSize,
+            absolutePos.col + actualWidth - vertBorderSize - 1,
+            absolutePos.row + actualHeight - horizBorderSize - 1 };
+    int contentWidth = contentBound.right - contentBound.left + 1;
+    int contentHeight = contentBound.bottom - contentBound.top + 1;
+    printedRows.clear();
+    if (rowTemplate == nullptr || contentWidth <= 0 || contentHeight <= 0) {
+        visibleRows = 0;
+        drawn = true;
+        return Reply::CONTINUE;
+    }
+
+    // Partially visible rows at the bottom are printed and clipped
+    visibleRows = (contentHeight + rowHeight - 1) / rowHeight;
+    fillRowPool(visibleRows, contentWidth);
+    setScrollPosition(scrollPos);
+
+    // Only the visible window of items is bound and printed
+    Position rowPos{ contentBound.left, contentBound.top };
+    for (int i = 0; i < visibleRows && scrollPos + i < itemCount; ++i) {
+        int item = scrollPos + i;
+        int slot = item % rowPool.size();
+        Box* row = rowPool[slot];
+
+        if (boundItems[slot] != item) {
+            if (rowBinder) {
+                rowBinder(*row, item);
+            }
+            boundItems[slot] = item;
+        }
+
+        if (drawMode) {
+            row->draw(rowPos, contentBound);
+        }
+        else {
+            row->buffer(rowPos, contentBound);
+        }
+        printedRows.push_back(row);
+        rowPos.row += rowHeight;
+    }
+
+    drawn = true;
+    return Reply::CONTINUE;
+}
+
+//------------------------------------------------------------------------------
+void VirtualContainer::fillRowPool(int rows, int width) {
+    // Resize existing rows if the content width or row height changed
+    if (width != rowWidth) {
+        for (Box* row : rowPool) {
+            row->setDimensions(width, rowHeight);
+        }
+        rowWidth = width;
+    }
+
+    if (static_cast<int>(rowPool.size()) >= rows) {
+        return;
+    }
+    while (static_cast<int>(rowPool.size()) < rows) {
+        Box* row = rowTemplate->copyBox();
+        row->setDimensions(width, rowHeight);
+        rowPool.push_back(row);
+    }
+
+    // Growing the pool changes the slot of each item
+    boundItems.assign(rowPool.size(), -1);
+}
+
+//------------------------------------------------------------------------------
+void VirtualContainer::clearRowPool() {
+    for (Box* row : rowPool) {
+        delete row;
+    }
+    rowPool.clear();
+    boundItems.clear();
+    printedRows.clear();
+    rowWidth = -1;
+}
+
+//------------------------------------------------------------------------------
+int VirtualContainer::getMaxScrollPosition() const {
+    // Keep the last item on the bottom row of the list
+    int fullRows = 1;
+    int contentHeight = actualHeight - (horizBorderSize * 2);
+    if (contentHeight > rowHeight) {
+        fullRows = contentHeight / rowHeight;
+    }
+
+    int maxScrollPos = itemCount - fullRows;
+    return maxScrollPos < 0 ? 0 : maxScrollPos;
+}
+
+}
\ No newline at end of file